@@ -0,0 +1,25 @@
+import os
+
+import numpy as np
+import pandas as pd
+import matplotlib.pyplot as plt
+
+# read validation data
+# analytical solution at t = 0.1 s (see 01_generate_input.py)
+test_path = os.path.join(os.getcwd(), 'validation', '01_validation', 'T.csv')
+test_df = pd.read_csv(test_path)
+x_test, y_test = test_df['% X'], test_df['Temperature']
+
+# read and plot calculated data for each time integration scheme
+for integrator in ['backwardeuler', 'bdf2', 'cranknicolson', 'sdirk2']:
+    calc_path = os.path.join(os.getcwd(), 'output', '01_output', 'temp_dom1_' + integrator + '.csv')
+    calc_df = pd.read_csv(calc_path)
+    x_calc, y_calc = calc_df['position_x'], calc_df['value']
+    plt.plot(x_calc, y_calc, 'o', fillstyle='none', label = 'MP2P (' + integrator + ')')
+
+# plot
+plt.plot(x_test, y_test, label = 'Analytical')
+plt.xlabel('Position [m]')
+plt.ylabel('Temperature [°C]')
+plt.legend()
+plt.show()
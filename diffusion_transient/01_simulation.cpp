@@ -0,0 +1,96 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../mp2p-fem1d/mp2p_fem1d.hpp"
+
+int main()
+{
+
+    // variables
+    double temp_init = 0.;
+    double temp_a = 50.;
+    double heatflux_b = 0.;
+    double heatcap = 1.;
+    double thermcond = 1.;
+    double heatgen = 0.;
+
+    // timestepping
+    double dt = 0.005;  // length of timestep
+    int num_ts = 20;  // number of timesteps (solution is output at t = num_ts * dt)
+
+    // time integration schemes to compare
+    std::vector<std::string> integrator_vec = {"backwardeuler", "bdf2", "cranknicolson", "sdirk2"};
+
+    // iterate through each time integration scheme
+    for (auto integrator_str : integrator_vec)
+    {
+
+        // initialize mesh
+        MeshLine2 mesh_dom1("input/01_input/mesh_point.csv", "input/01_input/mesh_element.csv");  // mesh for domain 1
+
+        // initialize boundary conditions
+        BoundaryLine2 boundary_dom1("input/01_input/boundary_flux.csv", "input/01_input/boundary_value.csv");
+        boundary_dom1.set_boundarycondition(0, "neumann", {heatflux_b});  // right flux is denoted as 0 in input files
+        boundary_dom1.set_boundarycondition(1, "dirichlet", {temp_a});  // left value is denoted as 1 in input files
+
+        // initialize integrals
+        IntegralLine2 integral_dom1(mesh_dom1);  // intergrals for domain 1
+
+        // initialize variables
+        // these are unknowns to be solved for
+        VariableLine2 temp_dom1(mesh_dom1, temp_init);  // supplied the initial condition for domain 1
+
+        // initialize scalars
+        // these are the known values
+        ScalarLine2 heatcap_dom1(mesh_dom1, heatcap);  // supplied a constant value for domain 1
+        ScalarLine2 thermcond_dom1(mesh_dom1, thermcond);  // supplied a constant value for domain 1
+        ScalarLine2 heatgen_dom1(mesh_dom1, heatgen);  // supplied a constant value for domain 1
+
+        // group mesh, boundary, etc. for physics
+        // the physics acts on domain 1, so group the mesh, etc. for domain 1
+        MeshField mesh_fld1({&mesh_dom1});
+        BoundaryField boundary_fld1({&boundary_dom1});
+        IntegralField integral_fld1({&integral_dom1});
+        VariableField temp_fld1({&temp_dom1});
+        ScalarField heatcap_fld1({&heatcap_dom1});
+        ScalarField thermcond_fld1({&thermcond_dom1});
+        ScalarField heatgen_fld1({&heatgen_dom1});
+
+        // initialize physics
+        // a * du/dt = -div(-b * grad(u)) + c
+        // value (to be solved for), u - temperature
+        // derivative coefficient, a - heat capacity
+        // diffusion coefficient, b - thermal conductivity
+        // generation coefficient, c - heat generation
+        PhysicsTransientDiffusion heattransfer(mesh_fld1, boundary_fld1, integral_fld1, temp_fld1, heatcap_fld1, thermcond_fld1, heatgen_fld1);
+
+        // load physics into matrix equation
+        // this will set up the system of equations to be solved for (Ax = b) in each timestep
+        MatrixEquationTransient matrixeq({&heattransfer});
+        matrixeq.set_integrator(integrator_str);
+
+        // the scalars do not depend on temperature
+        // M, K, and f are filled up once and reused in every timestep
+        matrixeq.set_operator_constant(true);
+
+        // iterate through each timestep
+        for (int ts = 1; ts <= num_ts; ts++)
+        {
+
+            // note: iteration within a timestep is not necessary in this example
+            // iteration is necessary only if the scalars are functions of the variables
+
+            // solve for x(t+1) and prepare for the next timestep
+            matrixeq.iterate_solution(dt);  // solve for x
+            matrixeq.store_solution();  // transfer values of x into variable objects
+            matrixeq.set_last_timestep_solution();  // x(t+1) becomes x(t)
+
+        }
+
+        // output results
+        std::cout << "Integrator: " << integrator_str << ", Time: " << num_ts*dt << "\n";
+        temp_dom1.output_csv("output/01_output/temp_dom1_" + integrator_str + ".csv");
+
+    }
+
+}
@@ -1,10 +1,23 @@
 #ifndef BOUNDARY_LINE2
 #define BOUNDARY_LINE2
+#include <algorithm>
 #include <fstream>
+#include <functional>
+#include <iostream>
 #include <sstream>
 #include <vector>
+#include "container_binary.hpp"
 #include "container_boundaryconfig.hpp"
 #include "container_typedef.hpp"
+#include "reader_binary.hpp"
+#include "reader_csv.hpp"
+#include "writer_binary.hpp"
+
+// resolved BC types
+const int boundary_type_none = 0;
+const int boundary_type_neumann = 1;
+const int boundary_type_robin = 2;
+const int boundary_type_dirichlet = 3;
 
 class BoundaryLine2
 {
@@ -18,6 +31,9 @@ class BoundaryLine2
         Path to CSV file with data for flux-type BCs.
     file_in_value_str_in : string
         Path to CSV file with data for value-type BCs.
+    file_in_binary_str_in : string
+        Path to binary file with data for flux-type and value-type BCs.
+        Used in place of the CSV files.
 
     Functions
     =========
@@ -25,6 +41,14 @@ class BoundaryLine2
         Assigns a BC type and parameters to a BC configuration ID.
     set_boundarycondition_parameter : void
         Assigns or modifies the parameters to a BC.
+    set_boundarycondition_series : void
+        Sets a parameter of a BC to follow a table of values in time.
+    set_boundarycondition_function : void
+        Sets a parameter of a BC to follow a function of time.
+    update_boundarycondition : bool
+        Evaluates the time-dependent parameters of BCs at a given time.
+    output_binary : void
+        Outputs a binary file with the flux and value BC data.
 
     Notes
     ====
@@ -34,6 +58,12 @@ class BoundaryLine2
         BC configuration ID
     Flux-type BCs add additional terms to the linearized equations (e.g., Neumann, Robin)
     Value-type BCs completely replace the linearized equations (e.g., Dirichlet)
+    The type and parameters of each BC element are resolved into flat vectors when BCs are set.
+    Physics read these vectors instead of comparing type strings in each matrix fill.
+    BCs must be modified with set_boundarycondition or set_boundarycondition_parameter to keep these vectors current.
+    Time-dependent parameters are evaluated by MatrixEquationTransient through update_boundarycondition.
+    The binary file is generated from the CSV files using output_binary.
+    Invalid or truncated binary files are reported on stderr and leave the boundary empty.
 
     */
 
@@ -42,6 +72,7 @@ class BoundaryLine2
     // file names
     std::string file_in_flux_str;
     std::string file_in_value_str;
+    std::string file_in_binary_str;
 
     // flux boundary condition data
     int num_element_flux_domain = 0;
@@ -59,9 +90,30 @@ class BoundaryLine2
     int num_boundaryconfig = 0;
     std::vector<BoundaryConfigStruct> boundaryconfig_vec;
 
+    // resolved boundary condition data
+    // type of each BC element is one of boundary_type_none, boundary_type_neumann, boundary_type_robin, or boundary_type_dirichlet
+    VectorInt element_flux_type_vec;
+    VectorDouble element_flux_parameter_vec;  // parameter k of flux BC element at 2*boundary_id + k
+    VectorInt element_value_type_vec;
+    VectorDouble element_value_parameter_vec;  // parameter of value BC element at boundary_id
+    std::vector<VectorInt> boundaryconfig_flux_id_vec;  // flux BC elements with each configuration
+    std::vector<VectorInt> boundaryconfig_value_id_vec;  // value BC elements with each configuration
+
+    // time-dependent boundary condition parameters
+    // each series sets one parameter of a BC configuration from a table (linear interpolation) or a function of time
+    VectorInt series_boundaryconfig_id_vec;
+    VectorInt series_parameter_id_vec;
+    std::vector<VectorDouble> series_time_vec;
+    std::vector<VectorDouble> series_value_vec;
+    std::vector<std::function<double(double)>> series_function_vec;  // empty for tables
+
     // functions
     void set_boundarycondition(int boundaryconfig_id, std::string type_str, VectorDouble parameter_vec);
     void set_boundarycondition_parameter(int boundaryconfig_id, VectorDouble parameter_vec);
+    void set_boundarycondition_series(int boundaryconfig_id, int parameter_id, VectorDouble time_vec, VectorDouble value_vec);
+    void set_boundarycondition_function(int boundaryconfig_id, int parameter_id, std::function<double(double)> parameter_function);
+    bool update_boundarycondition(double time);
+    void output_binary(std::string file_out_str);
 
     // default constructor
     BoundaryLine2()
@@ -81,54 +133,33 @@ class BoundaryLine2
         read_boundary_flux(file_in_flux_str);
         read_boundary_value(file_in_value_str);
 
-        // get largest boundary config id from flux BC
-        for (auto boundaryconfig_id : element_flux_boundaryconfig_id_vec)
-        {
-            if (boundaryconfig_id > num_boundaryconfig)
-            {
-                num_boundaryconfig = boundaryconfig_id;
-            }
-        }
+        // initialize boundary configurations
+        initialize_boundaryconfig();
 
-        // get largest boundary config id from value BC
-        for (auto boundaryconfig_id : element_value_boundaryconfig_id_vec)
-        {
-            if (boundaryconfig_id > num_boundaryconfig)
-            {
-                num_boundaryconfig = boundaryconfig_id;
-            }
-        }
+    }
 
-        // assume that first boundary config id is zero
-        // add one to get number of boundary config
-        num_boundaryconfig += 1;
+    // constructor for binary files
+    BoundaryLine2(std::string file_in_binary_str_in)
+    {
 
-        // initialize boundary config id vector
-        boundaryconfig_vec = std::vector<BoundaryConfigStruct>(num_boundaryconfig);
+        // store variables
+        file_in_binary_str = file_in_binary_str_in;
 
-        // initialize boundary config id vector with zero flux
-        BoundaryConfigStruct boundaryconfig_zeroflux;
-        boundaryconfig_zeroflux.type_str = "neumann";
-        boundaryconfig_zeroflux.parameter_vec = {0};
-        for (auto boundaryconfig_id : element_flux_boundaryconfig_id_vec)
-        {
-            boundaryconfig_vec[boundaryconfig_id] = boundaryconfig_zeroflux;
-        }
+        // read binary file and store boundary condition data
+        read_boundary_binary(file_in_binary_str);
 
-        // initialize boundary config id vector with zero values
-        BoundaryConfigStruct boundaryconfig_zerovalue;
-        boundaryconfig_zerovalue.type_str = "dirichlet";
-        boundaryconfig_zerovalue.parameter_vec = {0};
-        for (auto boundaryconfig_id : element_value_boundaryconfig_id_vec)
-        {
-            boundaryconfig_vec[boundaryconfig_id] = boundaryconfig_zerovalue;
-        }
+        // initialize boundary configurations
+        initialize_boundaryconfig();
 
     }
 
     private:
     void read_boundary_flux(std::string file_in_flux_str);
     void read_boundary_value(std::string file_in_value_str);
+    void read_boundary_binary(std::string file_in_binary_str);
+    void initialize_boundaryconfig();
+    void resolve_boundaryconfig(int boundaryconfig_id);
+    double evaluate_series(int series_id, double time);
 
 };
 
@@ -162,6 +193,9 @@ void BoundaryLine2::set_boundarycondition(int boundaryconfig_id, std::string typ
     boundaryconfig_vec[boundaryconfig_id].type_str = type_str;
     boundaryconfig_vec[boundaryconfig_id].parameter_vec = parameter_vec;
 
+    // update BC elements with this configuration
+    resolve_boundaryconfig(boundaryconfig_id);
+
 }
 
 void BoundaryLine2::set_boundarycondition_parameter(int boundaryconfig_id, VectorDouble parameter_vec)
@@ -181,120 +215,415 @@ void BoundaryLine2::set_boundarycondition_parameter(int boundaryconfig_id, Vecto
     =======
     (none)
 
+    Notes
+    =====
+    Only the parameters of BC elements with this configuration are updated.
+
     */
 
     // modify struct properties
     boundaryconfig_vec[boundaryconfig_id].parameter_vec = parameter_vec;
 
+    // update BC elements with this configuration
+    resolve_boundaryconfig(boundaryconfig_id);
+
 }
 
-void BoundaryLine2::read_boundary_flux(std::string file_in_flux_str)
+void BoundaryLine2::set_boundarycondition_series(int boundaryconfig_id, int parameter_id, VectorDouble time_vec, VectorDouble value_vec)
 {
+    /*
 
-    // read file with flux BC data
-    std::ifstream file_in_flux_stream(file_in_flux_str);
+    Sets a parameter of a BC to follow a table of values in time.
+
+    Arguments
+    =========
+    boundaryconfig_id : int
+        BC configuration ID.
+    parameter_id : int
+        Index of the parameter in the parameter vector of the BC (e.g., 0 for the value of a Dirichlet BC).
+    time_vec : VectorDouble
+        Times in increasing order.
+    value_vec : VectorDouble
+        Value of the parameter at each time.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    The value is linearly interpolated between times and held constant outside the table.
+    The type of BC must be set beforehand with set_boundarycondition.
+
+    */
+
+    series_boundaryconfig_id_vec.push_back(boundaryconfig_id);
+    series_parameter_id_vec.push_back(parameter_id);
+    series_time_vec.push_back(time_vec);
+    series_value_vec.push_back(value_vec);
+    series_function_vec.push_back(std::function<double(double)>());
+
+}
+
+void BoundaryLine2::set_boundarycondition_function(int boundaryconfig_id, int parameter_id, std::function<double(double)> parameter_function)
+{
+    /*
+
+    Sets a parameter of a BC to follow a function of time.
+
+    Arguments
+    =========
+    boundaryconfig_id : int
+        BC configuration ID.
+    parameter_id : int
+        Index of the parameter in the parameter vector of the BC (e.g., 0 for the value of a Dirichlet BC).
+    parameter_function : function<double(double)>
+        Function that returns the value of the parameter given the time.
 
-    // initialize for iteration
-    bool is_flux_header = true;  // true while reading header
-    std::string line_flux_str;  // stores lines in files
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    The function may capture variables or scalars by reference to depend on the state (e.g., the last stored solution).
+    The type of BC must be set beforehand with set_boundarycondition.
+
+    */
+
+    series_boundaryconfig_id_vec.push_back(boundaryconfig_id);
+    series_parameter_id_vec.push_back(parameter_id);
+    series_time_vec.push_back(VectorDouble());
+    series_value_vec.push_back(VectorDouble());
+    series_function_vec.push_back(parameter_function);
+
+}
+
+bool BoundaryLine2::update_boundarycondition(double time)
+{
+    /*
+
+    Evaluates the time-dependent parameters of BCs at a given time.
+
+    Arguments
+    =========
+    time : double
+        Time where parameters are evaluated.
 
-    // iterate for each line in the file
-    while (std::getline(file_in_flux_stream, line_flux_str))
+    Returns
+    =======
+    is_changed : bool
+        true if any parameter has changed.
+
+    Notes
+    =====
+    Only BC elements with a changed configuration are updated.
+
+    */
+
+    // evaluate each series
+    bool is_changed = false;
+    int num_series = series_boundaryconfig_id_vec.size();
+    for (int series_id = 0; series_id < num_series; series_id++)
     {
 
-        // skip header
-        if (is_flux_header)
+        // get parameter
+        int boundaryconfig_id = series_boundaryconfig_id_vec[series_id];
+        int parameter_id = series_parameter_id_vec[series_id];
+        VectorDouble &parameter_vec = boundaryconfig_vec[boundaryconfig_id].parameter_vec;
+        if (static_cast<int>(parameter_vec.size()) <= parameter_id)
         {
-            is_flux_header = false; // not reading header
-            continue;
+            parameter_vec.resize(parameter_id + 1, 0.);
         }
 
-        // count number of particles
-        num_element_flux_domain++;
+        // update parameter if changed
+        double parameter_value = evaluate_series(series_id, time);
+        if (parameter_vec[parameter_id] != parameter_value)
+        {
+            parameter_vec[parameter_id] = parameter_value;
+            resolve_boundaryconfig(boundaryconfig_id);
+            is_changed = true;
+        }
 
-        // convert line string into stringstream
-        std::stringstream line_flux_stream(line_flux_str);
+    }
 
-        // initialize for iteration
-        int value_flux_num = 0;  // counts position of value
-        std::string value_flux_str;  // stores values in lines
+    return is_changed;
 
-        // iterate through each value
-        while (std::getline(line_flux_stream, value_flux_str, ','))
-        {
+}
 
-            // store values in appropriate vector
-            switch (value_flux_num)
-            {
-                case 0: element_flux_gid_vec.push_back(std::stoi(value_flux_str)); break;
-                case 1: element_flux_pa_lid_vec.push_back(std::stoi(value_flux_str)); break;
-                case 2: element_flux_boundaryconfig_id_vec.push_back(std::stoi(value_flux_str)); break;
-            }
+void BoundaryLine2::read_boundary_flux(std::string file_in_flux_str)
+{
 
-            // increment value count
-            value_flux_num++;
+    // read file with flux BC data
+    ReaderCSV reader_csv(file_in_flux_str);
 
-        }
+    // allocate vectors
+    num_element_flux_domain = reader_csv.num_row;
+    element_flux_gid_vec.resize(num_element_flux_domain);
+    element_flux_pa_lid_vec.resize(num_element_flux_domain);
+    element_flux_boundaryconfig_id_vec.resize(num_element_flux_domain);
 
+    // store values in appropriate vector
+    for (int boundary_id = 0; boundary_id < num_element_flux_domain; boundary_id++)
+    {
+        element_flux_gid_vec[boundary_id] = reader_csv.get_value_int(boundary_id, 0);
+        element_flux_pa_lid_vec[boundary_id] = reader_csv.get_value_int(boundary_id, 1);
+        element_flux_boundaryconfig_id_vec[boundary_id] = reader_csv.get_value_int(boundary_id, 2);
     }
 
-    // close point file
-    file_in_flux_stream.close();    
-
 }
 
 void BoundaryLine2::read_boundary_value(std::string file_in_value_str)
 {
 
     // read file with value BC data
-    std::ifstream file_in_value_stream(file_in_value_str);
+    ReaderCSV reader_csv(file_in_value_str);
 
-    // initialize for iteration
-    bool is_value_header = true;  // true while reading header
-    std::string line_value_str;  // stores lines in files
+    // allocate vectors
+    num_element_value_domain = reader_csv.num_row;
+    element_value_gid_vec.resize(num_element_value_domain);
+    element_value_pa_lid_vec.resize(num_element_value_domain);
+    element_value_boundaryconfig_id_vec.resize(num_element_value_domain);
 
-    // iterate for each line in the file
-    while (std::getline(file_in_value_stream, line_value_str))
+    // store values in appropriate vector
+    for (int boundary_id = 0; boundary_id < num_element_value_domain; boundary_id++)
     {
+        element_value_gid_vec[boundary_id] = reader_csv.get_value_int(boundary_id, 0);
+        element_value_pa_lid_vec[boundary_id] = reader_csv.get_value_int(boundary_id, 1);
+        element_value_boundaryconfig_id_vec[boundary_id] = reader_csv.get_value_int(boundary_id, 2);
+    }
 
-        // skip header
-        if (is_value_header)
+}
+
+void BoundaryLine2::read_boundary_binary(std::string file_in_binary_str)
+{
+
+    // map binary file
+    // arrays: flux gid, flux pa_lid, flux config id, value gid, value pa_lid, value config id
+    ReaderBinary reader_binary(file_in_binary_str);
+    if (!reader_binary.is_valid || reader_binary.file_type != binary_file_boundary || reader_binary.num_array < 6)
+    {
+        std::cerr << "BoundaryLine2: " << file_in_binary_str << " is not a valid boundary file.\n";
+        return;
+    }
+
+    // get pointers to arrays in file
+    const int *element_flux_gid_ptr = reader_binary.get_array_int_ptr(0);
+    const int *element_flux_pa_lid_ptr = reader_binary.get_array_int_ptr(1);
+    const int *element_flux_boundaryconfig_id_ptr = reader_binary.get_array_int_ptr(2);
+    const int *element_value_gid_ptr = reader_binary.get_array_int_ptr(3);
+    const int *element_value_pa_lid_ptr = reader_binary.get_array_int_ptr(4);
+    const int *element_value_boundaryconfig_id_ptr = reader_binary.get_array_int_ptr(5);
+
+    // check types and lengths of arrays
+    // arrays of the same entity must have the same number of values
+    int num_element_flux_file = reader_binary.get_num_value(0);
+    int num_element_value_file = reader_binary.get_num_value(3);
+    bool is_array_valid = (
+        element_flux_gid_ptr && element_flux_pa_lid_ptr && element_flux_boundaryconfig_id_ptr &&
+        element_value_gid_ptr && element_value_pa_lid_ptr && element_value_boundaryconfig_id_ptr &&
+        reader_binary.get_num_value(1) == num_element_flux_file &&
+        reader_binary.get_num_value(2) == num_element_flux_file &&
+        reader_binary.get_num_value(4) == num_element_value_file &&
+        reader_binary.get_num_value(5) == num_element_value_file
+    );
+    if (!is_array_valid)
+    {
+        std::cerr << "BoundaryLine2: " << file_in_binary_str << " has arrays with unexpected types or lengths.\n";
+        return;
+    }
+
+    // store flux BC data
+    num_element_flux_domain = num_element_flux_file;
+    element_flux_gid_vec.assign(element_flux_gid_ptr, element_flux_gid_ptr + num_element_flux_domain);
+    element_flux_pa_lid_vec.assign(element_flux_pa_lid_ptr, element_flux_pa_lid_ptr + num_element_flux_domain);
+    element_flux_boundaryconfig_id_vec.assign(element_flux_boundaryconfig_id_ptr, element_flux_boundaryconfig_id_ptr + num_element_flux_domain);
+
+    // store value BC data
+    num_element_value_domain = num_element_value_file;
+    element_value_gid_vec.assign(element_value_gid_ptr, element_value_gid_ptr + num_element_value_domain);
+    element_value_pa_lid_vec.assign(element_value_pa_lid_ptr, element_value_pa_lid_ptr + num_element_value_domain);
+    element_value_boundaryconfig_id_vec.assign(element_value_boundaryconfig_id_ptr, element_value_boundaryconfig_id_ptr + num_element_value_domain);
+
+}
+
+void BoundaryLine2::output_binary(std::string file_out_str)
+{
+    /*
+
+    Outputs a binary file with the flux and value BC data.
+
+    Arguments
+    =========
+    file_out_str : string
+        Path to binary file.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    The file can be loaded using the BoundaryLine2 constructor for binary files.
+    This is used to convert the CSV files of a boundary into a single binary file.
+    BC types and parameters are not stored; these are set using set_boundarycondition.
+
+    */
+
+    // write arrays in the order expected by read_boundary_binary
+    WriterBinary writer_binary(binary_file_boundary);
+    writer_binary.add_array(element_flux_gid_vec);
+    writer_binary.add_array(element_flux_pa_lid_vec);
+    writer_binary.add_array(element_flux_boundaryconfig_id_vec);
+    writer_binary.add_array(element_value_gid_vec);
+    writer_binary.add_array(element_value_pa_lid_vec);
+    writer_binary.add_array(element_value_boundaryconfig_id_vec);
+    writer_binary.write_file(file_out_str);
+
+}
+
+void BoundaryLine2::initialize_boundaryconfig()
+{
+
+    // get largest boundary config id from flux BC
+    for (auto boundaryconfig_id : element_flux_boundaryconfig_id_vec)
+    {
+        if (boundaryconfig_id > num_boundaryconfig)
         {
-            is_value_header = false; // not reading header
-            continue;
+            num_boundaryconfig = boundaryconfig_id;
         }
+    }
 
-        // count number of particles
-        num_element_value_domain++;
+    // get largest boundary config id from value BC
+    for (auto boundaryconfig_id : element_value_boundaryconfig_id_vec)
+    {
+        if (boundaryconfig_id > num_boundaryconfig)
+        {
+            num_boundaryconfig = boundaryconfig_id;
+        }
+    }
 
-        // convert line string into stringstream
-        std::stringstream line_value_stream(line_value_str);
+    // assume that first boundary config id is zero
+    // add one to get number of boundary config
+    num_boundaryconfig += 1;
 
-        // initialize for iteration
-        int value_value_num = 0;  // counts position of value
-        std::string value_value_str;  // stores values in lines
+    // initialize boundary config id vector
+    boundaryconfig_vec = std::vector<BoundaryConfigStruct>(num_boundaryconfig);
 
-        // iterate through each value
-        while (std::getline(line_value_stream, value_value_str, ','))
-        {
+    // initialize boundary config id vector with zero flux
+    BoundaryConfigStruct boundaryconfig_zeroflux;
+    boundaryconfig_zeroflux.type_str = "neumann";
+    boundaryconfig_zeroflux.parameter_vec = {0};
+    for (auto boundaryconfig_id : element_flux_boundaryconfig_id_vec)
+    {
+        boundaryconfig_vec[boundaryconfig_id] = boundaryconfig_zeroflux;
+    }
 
-            // store values in appropriate vector
-            switch (value_value_num)
-            {
-                case 0: element_value_gid_vec.push_back(std::stoi(value_value_str)); break;
-                case 1: element_value_pa_lid_vec.push_back(std::stoi(value_value_str)); break;
-                case 2: element_value_boundaryconfig_id_vec.push_back(std::stoi(value_value_str)); break;
-            }
+    // initialize boundary config id vector with zero values
+    BoundaryConfigStruct boundaryconfig_zerovalue;
+    boundaryconfig_zerovalue.type_str = "dirichlet";
+    boundaryconfig_zerovalue.parameter_vec = {0};
+    for (auto boundaryconfig_id : element_value_boundaryconfig_id_vec)
+    {
+        boundaryconfig_vec[boundaryconfig_id] = boundaryconfig_zerovalue;
+    }
 
-            // increment value count
-            value_value_num++;
+    // group BC elements by configuration
+    boundaryconfig_flux_id_vec = std::vector<VectorInt>(num_boundaryconfig);
+    boundaryconfig_value_id_vec = std::vector<VectorInt>(num_boundaryconfig);
+    for (int boundary_id = 0; boundary_id < num_element_flux_domain; boundary_id++)
+    {
+        boundaryconfig_flux_id_vec[element_flux_boundaryconfig_id_vec[boundary_id]].push_back(boundary_id);
+    }
+    for (int boundary_id = 0; boundary_id < num_element_value_domain; boundary_id++)
+    {
+        boundaryconfig_value_id_vec[element_value_boundaryconfig_id_vec[boundary_id]].push_back(boundary_id);
+    }
 
-        }
+    // resolve type and parameters of each BC element
+    element_flux_type_vec = VectorInt(num_element_flux_domain, boundary_type_none);
+    element_flux_parameter_vec = VectorDouble(2*num_element_flux_domain, 0.);
+    element_value_type_vec = VectorInt(num_element_value_domain, boundary_type_none);
+    element_value_parameter_vec = VectorDouble(num_element_value_domain, 0.);
+    for (int boundaryconfig_id = 0; boundaryconfig_id < num_boundaryconfig; boundaryconfig_id++)
+    {
+        resolve_boundaryconfig(boundaryconfig_id);
+    }
+
+}
+
+void BoundaryLine2::resolve_boundaryconfig(int boundaryconfig_id)
+{
+
+    // convert type string into type constant
+    BoundaryConfigStruct &boundaryconfig = boundaryconfig_vec[boundaryconfig_id];
+    int boundary_type = boundary_type_none;
+    if (boundaryconfig.type_str == "neumann")
+    {
+        boundary_type = boundary_type_neumann;
+    }
+    else if (boundaryconfig.type_str == "robin")
+    {
+        boundary_type = boundary_type_robin;
+    }
+    else if (boundaryconfig.type_str == "dirichlet")
+    {
+        boundary_type = boundary_type_dirichlet;
+    }
+
+    // get parameters
+    // missing parameters are zero
+    int num_parameter = boundaryconfig.parameter_vec.size();
+    double parameter_0 = (num_parameter > 0) ? boundaryconfig.parameter_vec[0] : 0.;
+    double parameter_1 = (num_parameter > 1) ? boundaryconfig.parameter_vec[1] : 0.;
+
+    // update flux BC elements with this configuration
+    for (auto boundary_id : boundaryconfig_flux_id_vec[boundaryconfig_id])
+    {
+        element_flux_type_vec[boundary_id] = boundary_type;
+        element_flux_parameter_vec[2*boundary_id] = parameter_0;
+        element_flux_parameter_vec[2*boundary_id + 1] = parameter_1;
+    }
+
+    // update value BC elements with this configuration
+    for (auto boundary_id : boundaryconfig_value_id_vec[boundaryconfig_id])
+    {
+        element_value_type_vec[boundary_id] = boundary_type;
+        element_value_parameter_vec[boundary_id] = parameter_0;
+    }
+
+}
 
+double BoundaryLine2::evaluate_series(int series_id, double time)
+{
+
+    // evaluate function if given
+    if (series_function_vec[series_id])
+    {
+        return series_function_vec[series_id](time);
+    }
+
+    // hold first and last values outside the table
+    VectorDouble &time_vec = series_time_vec[series_id];
+    VectorDouble &value_vec = series_value_vec[series_id];
+    if (time_vec.empty())
+    {
+        return 0.;
+    }
+    if (time <= time_vec.front())
+    {
+        return value_vec.front();
+    }
+    if (time >= time_vec.back())
+    {
+        return value_vec.back();
     }
 
-    // close point file
-    file_in_value_stream.close();
+    // interpolate linearly between neighboring times
+    int indx_1 = std::upper_bound(time_vec.begin(), time_vec.end(), time) - time_vec.begin();
+    int indx_0 = indx_1 - 1;
+    double weight = (time - time_vec[indx_0])/(time_vec[indx_1] - time_vec[indx_0]);
+    return (1. - weight)*value_vec[indx_0] + weight*value_vec[indx_1];
 
 }
 
@@ -0,0 +1,30 @@
+#ifndef CONTAINER_BINARY
+#define CONTAINER_BINARY
+#include <cstdint>
+
+// layout of binary files with mesh and boundary data
+// header: magic string (8 bytes), file type (int64), number of arrays (int64)
+// table: one BinaryArrayStruct per array
+// data: contiguous arrays, each starting at a multiple of 8 bytes from the start of the file
+// values are stored in native byte order
+
+// identifies binary files
+const char binary_magic_arr[8] = {'M', 'P', '2', 'P', 'F', 'E', 'M', '1'};
+
+// file types
+const int64_t binary_file_mesh = 1;
+const int64_t binary_file_boundary = 2;
+
+// array types
+const int64_t binary_array_int = 0;  // int32
+const int64_t binary_array_double = 1;  // float64
+
+// entry in the table of arrays
+struct BinaryArrayStruct
+{
+    int64_t type;  // array type
+    int64_t num_value;  // number of values
+    int64_t offset;  // position of the first value in bytes from the start of the file
+};
+
+#endif
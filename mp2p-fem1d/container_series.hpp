@@ -0,0 +1,35 @@
+#ifndef CONTAINER_SERIES
+#define CONTAINER_SERIES
+#include <cstdint>
+
+// layout of binary files with the values of a variable or scalar over several timesteps
+// header: magic string (8 bytes), number of points (int64), global IDs (int32), x-coordinates (float64)
+// records: one SeriesRecordStruct followed by the encoded values for each timestep
+// the global IDs, x-coordinates, and each record start at a multiple of 8 bytes from the start of the file
+// an index file (file name + ".idx") stores the timestep and position of each record as pairs of int64
+// values are stored in native byte order
+
+// identifies binary series files
+const char series_magic_arr[8] = {'M', 'P', '2', 'P', 'S', 'E', 'R', '1'};
+
+// encoding of values in records
+const int64_t series_encoding_raw = 0;  // float64 values
+const int64_t series_encoding_compressed = 1;  // byte-shuffled, delta-coded, and run-length encoded float64 values
+
+// header of each record
+struct SeriesRecordStruct
+{
+    int64_t ts;  // timestep
+    int64_t encoding;  // encoding of values
+    int64_t num_value;  // number of values
+    int64_t num_byte;  // number of bytes of encoded values (excluding padding)
+};
+
+// entry in the index file
+struct SeriesIndexStruct
+{
+    int64_t ts;  // timestep
+    int64_t offset;  // position of the record in bytes from the start of the file
+};
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef CONTAINER_TRIPLET
+#define CONTAINER_TRIPLET
+#include <vector>
+#include "Eigen/Eigen"
+
+// typedef of triplets (row, column, value) for matrix assembly
+typedef Eigen::Triplet<double> Triplet;
+typedef std::vector<Triplet> VectorTriplet;
+
+#endif
@@ -1,5 +1,6 @@
 #ifndef CONTAINER_TYPEDEF
 #define CONTAINER_TYPEDEF
+#include <array>
 #include <unordered_map>
 #include <vector>
 
@@ -16,4 +17,13 @@ typedef std::vector<Vector1D> Vector2D;
 typedef std::vector<Vector2D> Vector3D;
 typedef std::vector<Vector3D> Vector4D;
 
+// fixed-size element records for integration
+// vectors of these are contiguous in memory
+typedef std::array<double, 2> Array1D;
+typedef std::array<Array1D, 2> Array2D;
+typedef std::array<Array2D, 2> Array3D;
+typedef std::vector<Array1D> VectorArray1D;
+typedef std::vector<Array2D> VectorArray2D;
+typedef std::vector<Array3D> VectorArray3D;
+
 #endif
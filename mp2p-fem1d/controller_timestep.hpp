@@ -0,0 +1,333 @@
+#ifndef CONTROLLER_TIMESTEP
+#define CONTROLLER_TIMESTEP
+#include <algorithm>
+#include <cmath>
+#include "Eigen/Eigen"
+
+class ControllerTimestep
+{
+    /*
+
+    Adjusts the length of the timestep in transient problems based on an estimate of the local error.
+
+    Variables
+    =========
+    tolerance_in : double
+        Relative and absolute tolerance of the local error.
+    dt_min_in : double
+        Smallest allowed timestep.
+    dt_max_in : double
+        Largest allowed timestep.
+
+    Functions
+    =========
+    get_error_norm : double
+        Returns the weighted norm of the local error estimate.
+    get_timestep_next : double
+        Returns the length of the next timestep to attempt.
+    set_tolerance : void
+        Sets the relative and absolute tolerances of the local error.
+    set_factor : void
+        Sets the safety factor and the limits on the change in timestep.
+    set_rejection_max : void
+        Sets the number of rejected attempts after which a timestep fails.
+    get_num_step_accepted : int
+        Returns the number of accepted timesteps.
+    get_num_step_rejected : int
+        Returns the number of rejected timesteps.
+    reset_count : void
+        Sets the number of accepted and rejected timesteps to zero.
+
+    Notes
+    =====
+    Used by MatrixEquationTransient::iterate_solution_adaptive.
+    The local error is estimated by step doubling (one step of dt vs. two steps of dt/2).
+    A timestep is accepted if the weighted error norm is at most 1.
+    A timestep fails if it is rejected num_rejection_max times in a row.
+    The weight of each entry is tolerance_abs + tolerance_rel * |x|.
+
+    */
+
+    public:
+
+    // tolerances
+    double tolerance_rel = 1e-3;
+    double tolerance_abs = 1e-3;
+
+    // limits on timestep
+    double dt_min = 0.;
+    double dt_max = 0.;
+    int num_rejection_max = 20;  // rejected attempts in a row before the timestep fails
+
+    // change in timestep
+    // dt_next = dt * factor_safety * (1/error)^(1/(order + 1)), limited to [factor_min, factor_max]
+    double factor_safety = 0.9;
+    double factor_min = 0.2;
+    double factor_max = 5.;
+
+    // step counts
+    int num_step_accepted = 0;
+    int num_step_rejected = 0;
+
+    // functions
+    double get_error_norm(Eigen::VectorXd &x_coarse_vec, Eigen::VectorXd &x_fine_vec, Eigen::VectorXd &x_last_timestep_vec);
+    double get_timestep_next(double dt, double error_norm, int order, bool is_rejected);
+    void set_tolerance(double tolerance_rel_in, double tolerance_abs_in);
+    void set_factor(double factor_safety_in, double factor_min_in, double factor_max_in);
+    void set_rejection_max(int num_rejection_max_in);
+    int get_num_step_accepted();
+    int get_num_step_rejected();
+    void reset_count();
+
+    // default constructor
+    ControllerTimestep()
+    {
+
+    }
+
+    // constructor
+    ControllerTimestep(double tolerance_in, double dt_min_in, double dt_max_in)
+    {
+        tolerance_rel = tolerance_in;
+        tolerance_abs = tolerance_in;
+        dt_min = dt_min_in;
+        dt_max = dt_max_in;
+    }
+
+};
+
+double ControllerTimestep::get_error_norm(Eigen::VectorXd &x_coarse_vec, Eigen::VectorXd &x_fine_vec, Eigen::VectorXd &x_last_timestep_vec)
+{
+    /*
+
+    Returns the weighted norm of the local error estimate.
+
+    Arguments
+    =========
+    x_coarse_vec : Eigen::VectorXd
+        x(t+dt) from one step of dt.
+    x_fine_vec : Eigen::VectorXd
+        x(t+dt) from two steps of dt/2.
+    x_last_timestep_vec : Eigen::VectorXd
+        x(t).
+
+    Returns
+    =======
+    error_norm : double
+        Root mean square of the weighted differences between x_coarse_vec and x_fine_vec.
+
+    */
+
+    // compute sum of squares of weighted differences
+    int num_equation = x_fine_vec.size();
+    double error_sum = 0.;
+    for (int indx_r = 0; indx_r < num_equation; indx_r++)
+    {
+        double x_scale = std::max(std::abs(x_fine_vec[indx_r]), std::abs(x_last_timestep_vec[indx_r]));
+        double error_weight = tolerance_abs + tolerance_rel*x_scale;
+        double error_value = (x_fine_vec[indx_r] - x_coarse_vec[indx_r])/error_weight;
+        error_sum += error_value*error_value;
+    }
+
+    // root mean square
+    if (num_equation == 0)
+    {
+        return 0.;
+    }
+    return std::sqrt(error_sum/num_equation);
+
+}
+
+double ControllerTimestep::get_timestep_next(double dt, double error_norm, int order, bool is_rejected)
+{
+    /*
+
+    Returns the length of the next timestep to attempt.
+
+    Arguments
+    =========
+    dt : double
+        Length of the last timestep attempted.
+    error_norm : double
+        Weighted norm of the local error estimate of the last timestep.
+    order : int
+        Order of accuracy of the time integration scheme.
+    is_rejected : bool
+        true if the last timestep was rejected.
+
+    Returns
+    =======
+    dt_next : double
+        Length of the next timestep.
+
+    Notes
+    =====
+    The exponent 1/(order + 1) follows from the local error of a scheme of the given order.
+    The timestep is not allowed to grow right after a rejection.
+    dt_next is limited to [dt_min, dt_max]; limits <= 0 are ignored.
+
+    */
+
+    // calculate change in timestep
+    double factor = factor_max;
+    if (error_norm > 0.)
+    {
+        factor = factor_safety*std::pow(1./error_norm, 1./(order + 1));
+    }
+    factor = std::min(factor_max, std::max(factor_min, factor));
+    if (is_rejected)
+    {
+        factor = std::min(factor, 1.);
+    }
+
+    // limit timestep
+    double dt_next = dt*factor;
+    if (dt_max > 0.)
+    {
+        dt_next = std::min(dt_next, dt_max);
+    }
+    if (dt_min > 0.)
+    {
+        dt_next = std::max(dt_next, dt_min);
+    }
+
+    return dt_next;
+
+}
+
+void ControllerTimestep::set_tolerance(double tolerance_rel_in, double tolerance_abs_in)
+{
+    /*
+
+    Sets the relative and absolute tolerances of the local error.
+
+    Arguments
+    =========
+    tolerance_rel_in : double
+        Relative tolerance.
+    tolerance_abs_in : double
+        Absolute tolerance.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    tolerance_rel = tolerance_rel_in;
+    tolerance_abs = tolerance_abs_in;
+
+}
+
+void ControllerTimestep::set_factor(double factor_safety_in, double factor_min_in, double factor_max_in)
+{
+    /*
+
+    Sets the safety factor and the limits on the change in timestep.
+
+    Arguments
+    =========
+    factor_safety_in : double
+        Safety factor applied to the optimal change in timestep (typically 0.8 to 0.9).
+    factor_min_in : double
+        Smallest ratio of the next timestep to the last one.
+    factor_max_in : double
+        Largest ratio of the next timestep to the last one.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    factor_safety = factor_safety_in;
+    factor_min = factor_min_in;
+    factor_max = factor_max_in;
+
+}
+
+void ControllerTimestep::set_rejection_max(int num_rejection_max_in)
+{
+    /*
+
+    Sets the number of rejected attempts after which a timestep fails.
+
+    Arguments
+    =========
+    num_rejection_max_in : int
+        Number of rejected attempts in a row.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    num_rejection_max = num_rejection_max_in;
+
+}
+
+int ControllerTimestep::get_num_step_accepted()
+{
+    /*
+
+    Returns the number of accepted timesteps.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    num_step_accepted : int
+        Number of accepted timesteps.
+
+    */
+
+    return num_step_accepted;
+
+}
+
+int ControllerTimestep::get_num_step_rejected()
+{
+    /*
+
+    Returns the number of rejected timesteps.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    num_step_rejected : int
+        Number of rejected timesteps.
+
+    */
+
+    return num_step_rejected;
+
+}
+
+void ControllerTimestep::reset_count()
+{
+    /*
+
+    Sets the number of accepted and rejected timesteps to zero.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    num_step_accepted = 0;
+    num_step_rejected = 0;
+
+}
+
+#endif
@@ -15,12 +15,15 @@ class IntegralLine2
     =========
     mesh_in : MeshLine2
         struct with mesh data.
+    is_analytic_in : bool
+        true if integrals are calculated from closed-form expressions.
+        false (default) if integrals are calculated using Gaussian quadrature.
 
     Functions
     =========
     evaluate_Ni_derivative : void
         Calculates test functions and their derivatives.
-        Must be called before integrals are evaluated.
+        Called automatically before integrals are evaluated.
     evaluate_integral_Ni : void
         Calculates the integral of Ni.
     evaluate_integral_derivative_Ni_x : void
@@ -36,10 +39,22 @@ class IntegralLine2
 
     Notes
     ====
-    The calculated integrals are stored in nested vectors.
+    The calculated integrals are stored in vectors of fixed-size arrays (one array per element).
     Values can be accessed from each vector using the following pattern:
         integral_vec[element_did][i][j]...
-    wherein element_gid is the domain element ID and i, j, ... are indices.
+    wherein element_did is the domain element ID and i, j, ... are indices.
+    Each vector is a single contiguous block of memory.
+    Each evaluate_* function computes its values only once; subsequent calls do nothing.
+    This allows several physics to share the same IntegralLine2 object.
+    If the closed-form expressions are used, only the element lengths (h) are stored by evaluate_Ni_derivative.
+    The test functions of line2 elements are linear, so both methods give the same integrals.
+    The closed-form expressions are:
+        integral of Ni = h/2
+        integral of d(Ni)/dx = -1, +1 (i = 0, 1)
+        integral of Ni * Nj = h/3 (i = j), h/6 (i != j)
+        integral of Ni * d(Nj)/dx = -1/2, +1/2 (j = 0, 1)
+        integral of div(Ni) dot div(Nj) = +1/h (i = j), -1/h (i != j)
+        integral of Ni * Nj * d(Nk)/dx = (integral of Ni * Nj) * (-1/h, +1/h) (k = 0, 1)
 
     */
 
@@ -48,18 +63,34 @@ class IntegralLine2
     // mesh
     MeshLine2 *mesh_ptr;
 
+    // integration method
+    bool is_analytic = false;
+
+    // element lengths
+    // used only with closed-form expressions
+    VectorDouble element_length_vec;
+
     // vectors with test functions and derivatives
-    Vector2D jacobian_determinant_vec;
-    Vector3D N_vec;
-    Vector3D derivative_N_x_vec;
+    VectorArray1D jacobian_determinant_vec;
+    VectorArray2D N_vec;
+    VectorArray2D derivative_N_x_vec;
 
     // vectors with integrals
-    Vector2D integral_Ni_vec;
-    Vector2D integral_derivative_Ni_x_vec;
-    Vector3D integral_Ni_Nj_vec;
-    Vector3D integral_Ni_derivative_Nj_x_vec;
-    Vector3D integral_div_Ni_dot_div_Nj_vec;
-    Vector4D integral_Ni_Nj_derivative_Nk_x_vec;
+    VectorArray1D integral_Ni_vec;
+    VectorArray1D integral_derivative_Ni_x_vec;
+    VectorArray2D integral_Ni_Nj_vec;
+    VectorArray2D integral_Ni_derivative_Nj_x_vec;
+    VectorArray2D integral_div_Ni_dot_div_Nj_vec;
+    VectorArray3D integral_Ni_Nj_derivative_Nk_x_vec;
+
+    // true if values are already computed
+    bool is_Ni_derivative_evaluated = false;
+    bool is_integral_Ni_evaluated = false;
+    bool is_integral_derivative_Ni_x_evaluated = false;
+    bool is_integral_Ni_Nj_evaluated = false;
+    bool is_integral_Ni_derivative_Nj_x_evaluated = false;
+    bool is_integral_div_Ni_dot_div_Nj_evaluated = false;
+    bool is_integral_Ni_Nj_derivative_Nk_x_evaluated = false;
 
     // functions for computing integrals
     void evaluate_Ni_derivative();
@@ -82,6 +113,13 @@ class IntegralLine2
         mesh_ptr = &mesh_in;
     }
 
+    // constructor with integration method
+    IntegralLine2(MeshLine2 &mesh_in, bool is_analytic_in)
+    {
+        mesh_ptr = &mesh_in;
+        is_analytic = is_analytic_in;
+    }
+
 };
 
 void IntegralLine2::evaluate_Ni_derivative()
@@ -89,7 +127,7 @@ void IntegralLine2::evaluate_Ni_derivative()
     /*
 
     Calculates test functions (N) and their derivatives.
-    Must be called before integrals are evaluated.
+    Called automatically before integrals are evaluated.
 
     Arguments
     =========
@@ -101,27 +139,44 @@ void IntegralLine2::evaluate_Ni_derivative()
 
     */
 
+    // skip if already computed
+    if (is_Ni_derivative_evaluated)
+    {
+        return;
+    }
+    is_Ni_derivative_evaluated = true;
+
+    // store only element lengths if closed-form expressions are used
+    if (is_analytic)
+    {
+        element_length_vec.resize(mesh_ptr->num_element_domain);
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
+        {
+            double x0 = mesh_ptr->point_position_x_vec[mesh_ptr->element_p0_did_vec[element_did]];
+            double x1 = mesh_ptr->point_position_x_vec[mesh_ptr->element_p1_did_vec[element_did]];
+            element_length_vec[element_did] = x1 - x0;
+        }
+        return;
+    }
+
     // integration points
     // dimensionless coordinates if element is scaled to [-1, 1]
     const double M_1_SQRT_3 = 1./sqrt(3);
     double a_arr[2] = {-M_1_SQRT_3, +M_1_SQRT_3};
 
+    // allocate vectors
+    // one fixed-size array per element
+    jacobian_determinant_vec.resize(mesh_ptr->num_element_domain);
+    N_vec.resize(mesh_ptr->num_element_domain);
+    derivative_N_x_vec.resize(mesh_ptr->num_element_domain);
+
     // iterate for each domain element
     for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
     {
 
-        // initialize
-        Vector1D jacobian_determinant_part_ml_vec;
-        Vector2D N_part_ml_vec;
-        Vector2D derivative_N_x_part_ml_vec;
-
-        // get global ID of points around element
-        int p0_gid = mesh_ptr->element_p0_gid_vec[element_did];
-        int p1_gid = mesh_ptr->element_p1_gid_vec[element_did];
-
-        // get domain ID of points
-        int p0_did = mesh_ptr->point_gid_to_did_map[p0_gid];
-        int p1_did = mesh_ptr->point_gid_to_did_map[p1_gid];
+        // get domain ID of points around element
+        int p0_did = mesh_ptr->element_p0_did_vec[element_did];
+        int p1_did = mesh_ptr->element_p1_did_vec[element_did];
 
         // get x values of points
         double x0 = mesh_ptr->point_position_x_vec[p0_did];
@@ -131,10 +186,6 @@ void IntegralLine2::evaluate_Ni_derivative()
         for (int indx_l = 0; indx_l < 2; indx_l++)
         {
 
-            // initialize
-            Vector1D N_part_mli_vec;
-            Vector1D derivative_N_x_part_mli_vec;
-
             // get a values where function is evaluated
             double a = a_arr[indx_l];
 
@@ -169,23 +220,16 @@ void IntegralLine2::evaluate_Ni_derivative()
                 double derivative_N_x = derivative_N_a*jacobian_inverse;
 
                 // store in vectors
-                N_part_mli_vec.push_back(N);
-                derivative_N_x_part_mli_vec.push_back(derivative_N_x);
+                N_vec[element_did][indx_l][indx_i] = N;
+                derivative_N_x_vec[element_did][indx_l][indx_i] = derivative_N_x;
 
             }
 
             // store in vectors
-            jacobian_determinant_part_ml_vec.push_back(jacobian_determinant);
-            N_part_ml_vec.push_back(N_part_mli_vec);
-            derivative_N_x_part_ml_vec.push_back(derivative_N_x_part_mli_vec);
+            jacobian_determinant_vec[element_did][indx_l] = jacobian_determinant;
 
         }
 
-        // store in vectors
-        jacobian_determinant_vec.push_back(jacobian_determinant_part_ml_vec);
-        N_vec.push_back(N_part_ml_vec);
-        derivative_N_x_vec.push_back(derivative_N_x_part_ml_vec);
-        
     }
 
 }
@@ -206,11 +250,35 @@ void IntegralLine2::evaluate_integral_Ni()
 
     */
 
+    // skip if already computed
+    if (is_integral_Ni_evaluated)
+    {
+        return;
+    }
+    is_integral_Ni_evaluated = true;
+
+    // test functions and derivatives are needed
+    evaluate_Ni_derivative();
+
+    // allocate vector
+    // one fixed-size array per element
+    integral_Ni_vec.resize(mesh_ptr->num_element_domain);
+
+    // use closed-form expressions if enabled
+    if (is_analytic)
+    {
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
+        {
+            double h = element_length_vec[element_did];
+            integral_Ni_vec[element_did] = {0.5*h, 0.5*h};
+        }
+        return;
+    }
+
     // iterate for each domain element
     for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++){  
     
     // iterate for each test function combination
-    Vector1D integral_part_i_vec;
     for (int indx_i = 0; indx_i < 2; indx_i++){  
         
         // iterate for each integration point
@@ -219,10 +287,9 @@ void IntegralLine2::evaluate_integral_Ni()
         {
             integral_value += jacobian_determinant_vec[element_did][indx_l] * N_vec[element_did][indx_l][indx_i];
         }
-        integral_part_i_vec.push_back(integral_value);
+        integral_Ni_vec[element_did][indx_i] = integral_value;
     
     }
-    integral_Ni_vec.push_back(integral_part_i_vec);
 
     }
 
@@ -243,12 +310,35 @@ void IntegralLine2::evaluate_integral_derivative_Ni_x()
     (none)
 
     */
-    
+
+    // skip if already computed
+    if (is_integral_derivative_Ni_x_evaluated)
+    {
+        return;
+    }
+    is_integral_derivative_Ni_x_evaluated = true;
+
+    // test functions and derivatives are needed
+    evaluate_Ni_derivative();
+
+    // allocate vector
+    // one fixed-size array per element
+    integral_derivative_Ni_x_vec.resize(mesh_ptr->num_element_domain);
+
+    // use closed-form expressions if enabled
+    if (is_analytic)
+    {
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
+        {
+            integral_derivative_Ni_x_vec[element_did] = {-1., +1.};
+        }
+        return;
+    }
+
     // iterate for each domain element
     for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++){  
     
     // iterate for each test function combination
-    Vector1D integral_part_i_vec;
     for (int indx_i = 0; indx_i < 2; indx_i++){  
         
         // iterate for each integration point
@@ -257,10 +347,9 @@ void IntegralLine2::evaluate_integral_derivative_Ni_x()
         {
             integral_value += jacobian_determinant_vec[element_did][indx_l] * derivative_N_x_vec[element_did][indx_l][indx_i];
         }
-        integral_part_i_vec.push_back(integral_value);
+        integral_derivative_Ni_x_vec[element_did][indx_i] = integral_value;
     
     }
-    integral_derivative_Ni_x_vec.push_back(integral_part_i_vec);
 
     }
 
@@ -282,13 +371,36 @@ void IntegralLine2::evaluate_integral_Ni_Nj()
 
     */
 
+    // skip if already computed
+    if (is_integral_Ni_Nj_evaluated)
+    {
+        return;
+    }
+    is_integral_Ni_Nj_evaluated = true;
+
+    // test functions and derivatives are needed
+    evaluate_Ni_derivative();
+
+    // allocate vector
+    // one fixed-size array per element
+    integral_Ni_Nj_vec.resize(mesh_ptr->num_element_domain);
+
+    // use closed-form expressions if enabled
+    if (is_analytic)
+    {
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
+        {
+            double h = element_length_vec[element_did];
+            integral_Ni_Nj_vec[element_did] = {{{h/3., h/6.}, {h/6., h/3.}}};
+        }
+        return;
+    }
+
     // iterate for each domain element
     for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++){  
     
     // iterate for each test function combination
-    Vector2D integral_part_i_vec;
     for (int indx_i = 0; indx_i < 2; indx_i++){  
-    Vector1D integral_part_ij_vec;
     for (int indx_j = 0; indx_j < 2; indx_j++){
         
         // iterate for each integration point
@@ -297,12 +409,10 @@ void IntegralLine2::evaluate_integral_Ni_Nj()
         {
             integral_value += jacobian_determinant_vec[element_did][indx_l] * N_vec[element_did][indx_l][indx_i] * N_vec[element_did][indx_l][indx_j];
         }
-        integral_part_ij_vec.push_back(integral_value);
+        integral_Ni_Nj_vec[element_did][indx_i][indx_j] = integral_value;
     
     }
-    integral_part_i_vec.push_back(integral_part_ij_vec);
     }
-    integral_Ni_Nj_vec.push_back(integral_part_i_vec);
 
     }
 
@@ -324,13 +434,35 @@ void IntegralLine2::evaluate_integral_Ni_derivative_Nj_x()
 
     */
 
+    // skip if already computed
+    if (is_integral_Ni_derivative_Nj_x_evaluated)
+    {
+        return;
+    }
+    is_integral_Ni_derivative_Nj_x_evaluated = true;
+
+    // test functions and derivatives are needed
+    evaluate_Ni_derivative();
+
+    // allocate vector
+    // one fixed-size array per element
+    integral_Ni_derivative_Nj_x_vec.resize(mesh_ptr->num_element_domain);
+
+    // use closed-form expressions if enabled
+    if (is_analytic)
+    {
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
+        {
+            integral_Ni_derivative_Nj_x_vec[element_did] = {{{-0.5, +0.5}, {-0.5, +0.5}}};
+        }
+        return;
+    }
+
     // iterate for each domain element
     for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++){  
     
     // iterate for each test function combination
-    Vector2D integral_part_i_vec;
     for (int indx_i = 0; indx_i < 2; indx_i++){  
-    Vector1D integral_part_ij_vec;
     for (int indx_j = 0; indx_j < 2; indx_j++){
         
         // iterate for each integration point
@@ -339,12 +471,10 @@ void IntegralLine2::evaluate_integral_Ni_derivative_Nj_x()
         {
             integral_value += jacobian_determinant_vec[element_did][indx_l] * N_vec[element_did][indx_l][indx_i] * derivative_N_x_vec[element_did][indx_l][indx_j];
         }
-        integral_part_ij_vec.push_back(integral_value);
+        integral_Ni_derivative_Nj_x_vec[element_did][indx_i][indx_j] = integral_value;
     
     }
-    integral_part_i_vec.push_back(integral_part_ij_vec);
     }
-    integral_Ni_derivative_Nj_x_vec.push_back(integral_part_i_vec);
 
     }
 
@@ -366,13 +496,36 @@ void IntegralLine2::evaluate_integral_div_Ni_dot_div_Nj()
 
     */
 
+    // skip if already computed
+    if (is_integral_div_Ni_dot_div_Nj_evaluated)
+    {
+        return;
+    }
+    is_integral_div_Ni_dot_div_Nj_evaluated = true;
+
+    // test functions and derivatives are needed
+    evaluate_Ni_derivative();
+
+    // allocate vector
+    // one fixed-size array per element
+    integral_div_Ni_dot_div_Nj_vec.resize(mesh_ptr->num_element_domain);
+
+    // use closed-form expressions if enabled
+    if (is_analytic)
+    {
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
+        {
+            double h = element_length_vec[element_did];
+            integral_div_Ni_dot_div_Nj_vec[element_did] = {{{+1./h, -1./h}, {-1./h, +1./h}}};
+        }
+        return;
+    }
+
     // iterate for each domain element
     for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++){  
     
     // iterate for each test function combination
-    Vector2D integral_part_i_vec;
     for (int indx_i = 0; indx_i < 2; indx_i++){  
-    Vector1D integral_part_ij_vec;
     for (int indx_j = 0; indx_j < 2; indx_j++){
         
         // iterate for each integration point
@@ -381,12 +534,10 @@ void IntegralLine2::evaluate_integral_div_Ni_dot_div_Nj()
         {
             integral_value += jacobian_determinant_vec[element_did][indx_l] * derivative_N_x_vec[element_did][indx_l][indx_i] * derivative_N_x_vec[element_did][indx_l][indx_j];
         }
-        integral_part_ij_vec.push_back(integral_value);
+        integral_div_Ni_dot_div_Nj_vec[element_did][indx_i][indx_j] = integral_value;
     
     }
-    integral_part_i_vec.push_back(integral_part_ij_vec);
     }
-    integral_div_Ni_dot_div_Nj_vec.push_back(integral_part_i_vec);
 
     }
 
@@ -408,15 +559,39 @@ void IntegralLine2::evaluate_integral_Ni_Nj_derivative_Nk_x()
 
     */
 
+    // skip if already computed
+    if (is_integral_Ni_Nj_derivative_Nk_x_evaluated)
+    {
+        return;
+    }
+    is_integral_Ni_Nj_derivative_Nk_x_evaluated = true;
+
+    // test functions and derivatives are needed
+    evaluate_Ni_derivative();
+
+    // allocate vector
+    // one fixed-size array per element
+    integral_Ni_Nj_derivative_Nk_x_vec.resize(mesh_ptr->num_element_domain);
+
+    // use closed-form expressions if enabled
+    if (is_analytic)
+    {
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
+        {
+            integral_Ni_Nj_derivative_Nk_x_vec[element_did] = {{
+                {{{-1./3., +1./3.}, {-1./6., +1./6.}}},
+                {{{-1./6., +1./6.}, {-1./3., +1./3.}}}
+            }};
+        }
+        return;
+    }
+
     // iterate for each domain element
     for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++){  
     
     // iterate for each test function combination
-    Vector3D integral_part_i_vec;
     for (int indx_i = 0; indx_i < 2; indx_i++){  
-    Vector2D integral_part_ij_vec;
     for (int indx_j = 0; indx_j < 2; indx_j++){
-    Vector1D integral_part_ijk_vec;
     for (int indx_k = 0; indx_k < 2; indx_k++){
 
         // iterate for each integration point
@@ -425,14 +600,11 @@ void IntegralLine2::evaluate_integral_Ni_Nj_derivative_Nk_x()
         {
             integral_value += jacobian_determinant_vec[element_did][indx_l] * N_vec[element_did][indx_l][indx_i] * N_vec[element_did][indx_l][indx_j] * derivative_N_x_vec[element_did][indx_l][indx_k];
         }
-        integral_part_ijk_vec.push_back(integral_value);
+        integral_Ni_Nj_derivative_Nk_x_vec[element_did][indx_i][indx_j][indx_k] = integral_value;
     
     }
-    integral_part_ij_vec.push_back(integral_part_ijk_vec);
     }
-    integral_part_i_vec.push_back(integral_part_ij_vec);
     }
-    integral_Ni_Nj_derivative_Nk_x_vec.push_back(integral_part_i_vec);
 
     }
 
@@ -1,10 +1,16 @@
 #ifndef MATRIXEQUATION_STEADY
 #define MATRIXEQUATION_STEADY
+#include <algorithm>
 #include <set>
 #include <vector>
 #include "Eigen/Eigen"
+#include "container_triplet.hpp"
+#include "container_typedef.hpp"
+#include "matrixsolver_base.hpp"
+#include "matrixsolver_sparselu.hpp"
 #include "physicssteady_base.hpp"
 #include "variable_field.hpp"
+#include "variable_line2.hpp"
 
 class MatrixEquationSteady
 {
@@ -19,15 +25,30 @@ class MatrixEquationSteady
 
     Functions
     =========
-    iterate_solution : void
+    iterate_solution : bool
         Solves for x in Ax = b.
-        Uses the currently stored values in A and b.
+        A and b are reset and filled up by the physics in each call.
+    set_newton : void
+        Sets whether Newton iterations are used instead of Picard (fixed-point) iterations.
+    set_anderson : void
+        Sets the number of previous iterates mixed by Anderson acceleration.
+    reset_anderson : void
+        Clears the previous iterates kept by Anderson acceleration.
+    set_condensed : void
+        Sets whether unknowns with value BCs are removed from the system that is solved.
     store_solution : void
         Transfers the solutions in x into variable objects.
+    set_solver : void
+        Sets the solver used for the matrix equation.
 
     Notes
     =====
     In the code; A, x, and b are referred to as a_mat, x_vec, and b_vec respectively.
+    is_valid is false if the physics could not be loaded into the matrix equation (see PhysicsSteadyBase::check_derivative_variable); iterate_solution then returns false without solving.
+    iterate_solution also returns false if the solver fails; x is then left unchanged (direct solvers) or at the last iterate (iterative solvers).
+    With Newton iterations, the physics also add their Jacobian contributions to A and b in each call.
+    With Anderson acceleration, the solution of Ax = b is mixed with previous iterates before it is stored in x.
+    With condensed numbering, only the rows and columns of unknowns without value BCs are passed to the solver.
 
     */
 
@@ -37,15 +58,62 @@ class MatrixEquationSteady
     std::vector<PhysicsSteadyBase*> physics_ptr_vec;
     std::vector<VariableField*> variable_field_ptr_vec;
 
+    // variables and their rows in x_vec
+    // row of each point at variable_point_vec_row_vec[indx_v][point_did]
+    std::vector<VariableLine2*> variable_ptr_vec;
+    std::vector<VectorInt> variable_point_vec_row_vec;
+
+    // false if the physics could not be loaded into the matrix equation
+    bool is_valid = true;
+
     // matrix equation variables
     Eigen::SparseMatrix<double> a_mat;
     Eigen::VectorXd b_vec;
     Eigen::VectorXd x_vec;
     int num_equation = 0;
 
+    // nonlinear iterations
+    bool is_newton = false;
+
+    // Anderson acceleration
+    // differences between successive iterates are stored in ring columns
+    // g is the solution of Ax = b given x; f = g - x is the fixed-point residual
+    int num_anderson = 0;  // 0 if disabled
+    int anderson_count = 0;  // number of residuals computed since reset
+    int anderson_col = 0;  // next column to overwrite
+    Eigen::MatrixXd anderson_dg_mat;
+    Eigen::MatrixXd anderson_df_mat;
+    Eigen::VectorXd anderson_g_last_vec;
+    Eigen::VectorXd anderson_f_last_vec;
+    Eigen::VectorXd x_iterate_vec;
+
+    // condensed system without unknowns that have value BCs
+    // free unknowns are solved for; constrained unknowns are fixed by value BCs
+    bool is_condensed = false;
+    VectorInt free_row_vec;  // key: row in condensed system; value: row in A
+    VectorInt constrained_row_vec;  // row in A of each constrained unknown
+    VectorInt constrained_mat_slot_vec;  // diagonal entry of each constrained unknown
+    VectorInt free_mat_slot_vec;  // key: position in condensed A; value: position in A
+    VectorInt coupling_mat_slot_vec;  // entries of A in free rows and constrained columns
+    VectorInt coupling_row_vec;  // row in condensed system of each entry
+    VectorInt coupling_col_vec;  // column in A of each entry
+    Eigen::SparseMatrix<double> a_free_mat;
+    Eigen::VectorXd b_free_vec;
+    Eigen::VectorXd x_free_vec;
+
+    // solver
+    // sparse LU is used unless another solver is set
+    MatrixSolverBase *solver_ptr = nullptr;
+    MatrixSolverSparseLU solver_sparselu;
+
     // functions
-    void iterate_solution();
+    bool iterate_solution();
+    void set_newton(bool is_newton_in);
+    void set_anderson(int num_anderson_in);
+    void reset_anderson();
+    void set_condensed(bool is_condensed_in);
     void store_solution();
+    void set_solver(MatrixSolverBase &solver_in);
 
     // default constructor
     MatrixEquationSteady()
@@ -122,12 +190,40 @@ class MatrixEquationSteady
         // convert to vector
         variable_field_ptr_vec = std::vector<VariableField*>(variable_field_ptr_set.begin(), variable_field_ptr_set.end());
 
+        // remove Jacobian derivatives with respect to variables outside of this matrix equation
+        // these have no columns in a_mat; the matrix equation is marked invalid if any are found
+        for (auto physics_ptr : physics_ptr_vec)
+        {
+            if (!physics_ptr->check_derivative_variable(variable_field_ptr_set))
+            {
+                is_valid = false;
+            }
+        }
+
         // initialize matrix equation variables
-        a_mat = Eigen::SparseMatrix<double> (num_equation, num_equation);
         b_vec = Eigen::VectorXd::Zero(num_equation);
         x_vec = Eigen::VectorXd::Zero(num_equation);
         
-        // populate x_vec with initial values
+        // generate sparsity pattern of a_mat
+        // each physics adds the entries that it fills up
+        VectorTriplet a_triplet_vec;
+        for (auto physics_ptr : physics_ptr_vec)
+        {
+            physics_ptr->matrix_pattern(a_triplet_vec);
+        }
+        a_mat = Eigen::SparseMatrix<double> (num_equation, num_equation);
+        a_mat.setFromTriplets(a_triplet_vec.begin(), a_triplet_vec.end());
+        a_mat.makeCompressed();
+
+        // store positions of entries in the compressed storage of a_mat
+        // physics use these to fill up a_mat without searching for entries
+        for (auto physics_ptr : physics_ptr_vec)
+        {
+            physics_ptr->set_matrix_slot(a_mat);
+        }
+        
+        // generate rows of variable points in x_vec
+        // these replace global to field ID lookups when x_vec is read or written
 
         // iterate through each variable field
         for (auto variable_field_ptr : variable_field_ptr_vec)
@@ -141,37 +237,50 @@ class MatrixEquationSteady
             for (auto variable_ptr : variable_field_ptr->variable_l2_ptr_vec)
             {
 
-                // iterate through each global ID
-                for (auto point_gid : variable_ptr->mesh_ptr->point_gid_vec)
-                {
+                // initialize rows of points in variable
+                VectorInt point_vec_row_vec(variable_ptr->num_point_domain);
 
-                    // get domain and field IDs
+                // iterate through each domain point
+                for (int point_did = 0; point_did < variable_ptr->num_point_domain; point_did++)
+                {
+                    int point_gid = variable_ptr->mesh_ptr->point_gid_vec[point_did];
                     int point_fid = variable_field_ptr->point_gid_to_fid_map[point_gid];
-                    int point_did = variable_ptr->mesh_ptr->point_gid_to_did_map[point_gid];
+                    point_vec_row_vec[point_did] = start_row + point_fid;
+                }
 
-                    // get value from variable
-                    double value = variable_ptr->point_value_vec[point_did];
+                // store variable and rows
+                variable_ptr_vec.push_back(variable_ptr);
+                variable_point_vec_row_vec.push_back(point_vec_row_vec);
 
-                    // store value in x_vec
-                    int vec_row = start_row + point_fid;
-                    x_vec.coeffRef(vec_row) = value;
+            }
 
-                }
+        }
 
+        // populate x_vec with initial values
+        for (int indx_v = 0; indx_v < static_cast<int>(variable_ptr_vec.size()); indx_v++)
+        {
+            VariableLine2 *variable_ptr = variable_ptr_vec[indx_v];
+            const int *point_vec_row_ptr = variable_point_vec_row_vec[indx_v].data();
+            for (int point_did = 0; point_did < variable_ptr->num_point_domain; point_did++)
+            {
+                x_vec[point_vec_row_ptr[point_did]] = variable_ptr->point_value_vec[point_did];
             }
-
         }
 
     }
 
+    private:
+    void accelerate_solution();
+    void solve_condensed(MatrixSolverBase *solver_use_ptr);
+
 };
 
-void MatrixEquationSteady::iterate_solution()
+bool MatrixEquationSteady::iterate_solution()
 {
     /*
     
     Solves for x in Ax = b.
-    Uses the currently stored values in A and b.
+    A and b are reset and filled up by the physics in each call.
 
     Arguments
     =========
@@ -179,10 +288,23 @@ void MatrixEquationSteady::iterate_solution()
 
     Returns
     =======
-    (none)
+    is_solved : bool
+        true if x was updated.
+        false if the matrix equation is invalid (see is_valid) or the solver failed (see MatrixSolverBase::get_is_converged).
 
     */
 
+    // skip invalid matrix equations
+    if (!is_valid)
+    {
+        return false;
+    }
+
+    // reset a_mat and b_vec
+    // values are zeroed in place so the sparsity pattern and storage are kept
+    a_mat.coeffs().setZero();
+    b_vec.setZero();
+
     // fill up a_mat and b_vec with each physics
     for (auto physics_ptr : physics_ptr_vec)
     {
@@ -190,63 +312,377 @@ void MatrixEquationSteady::iterate_solution()
 
     }
 
+    // add Jacobian contributions for Newton iterations
+    if (is_newton)
+    {
+        for (auto physics_ptr : physics_ptr_vec)
+        {
+            physics_ptr->matrix_fill_jacobian(a_mat, b_vec, x_vec);
+        }
+    }
+
+    // eliminate known values from the columns of a_mat
+    // done after all physics so that entries added by any of them are eliminated
+    for (auto physics_ptr : physics_ptr_vec)
+    {
+        physics_ptr->matrix_fill_elimination(a_mat, b_vec);
+    }
+
+    // keep iterate for Anderson acceleration
+    if (num_anderson > 0)
+    {
+        x_iterate_vec = x_vec;
+    }
+
     // solve the matrix equation
-    Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> solver;
-    solver.analyzePattern(a_mat);
-    solver.factorize(a_mat);
-    x_vec = solver.solve(b_vec);
+    MatrixSolverBase *solver_use_ptr = (solver_ptr != nullptr) ? solver_ptr : &solver_sparselu;
+    if (is_condensed)
+    {
+        solve_condensed(solver_use_ptr);
+    }
+    else
+    {
+        solver_use_ptr->solve(a_mat, b_vec, x_vec);
+    }
+
+    // stop if the solver failed
+    // failed solutions are not mixed into the Anderson history
+    if (!solver_use_ptr->get_is_converged())
+    {
+        return false;
+    }
+
+    // mix with previous iterates
+    if (num_anderson > 0)
+    {
+        accelerate_solution();
+    }
+
+    return true;
 
 }
 
-void MatrixEquationSteady::store_solution()
+void MatrixEquationSteady::set_newton(bool is_newton_in)
 {
     /*
     
-    Transfers the solutions in x into variable objects.
+    Sets whether Newton iterations are used instead of Picard (fixed-point) iterations.
 
     Arguments
     =========
+    is_newton_in : bool
+        true if Newton iterations are used.
+
+    Returns
+    =======
     (none)
 
+    Notes
+    =====
+    Each call to iterate_solution then performs one Newton step about the current x.
+    The coefficients and their derivatives (e.g., set_generation_derivative in the physics) must be updated from the current solution before each call.
+    Terms without supplied derivatives are treated as in Picard iterations.
+
+    */
+
+    is_newton = is_newton_in;
+
+}
+
+void MatrixEquationSteady::set_anderson(int num_anderson_in)
+{
+    /*
+    
+    Sets the number of previous iterates mixed by Anderson acceleration.
+
+    Arguments
+    =========
+    num_anderson_in : int
+        Number of previous iterates (0 to disable Anderson acceleration).
+
     Returns
     =======
     (none)
 
+    Notes
+    =====
+    Intended for Picard iterations where the coefficients are updated from the stored solution after each call to iterate_solution.
+    Each call then treats the solution of Ax = b as g(x) and stores x = g - dG gamma in x_vec, where gamma minimizes |f - dF gamma|.
+    dG and dF hold the differences between the last num_anderson values of g and of f = g - x.
+    Typical values are 3 to 10.
+
     */
 
-    // iterate through each variable field
-    for (auto variable_field_ptr : variable_field_ptr_vec)
+    num_anderson = (num_anderson_in > 0) ? num_anderson_in : 0;
+    reset_anderson();
+
+}
+
+void MatrixEquationSteady::reset_anderson()
+{
+    /*
+    
+    Clears the previous iterates kept by Anderson acceleration.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Should be called before starting a new set of iterations (e.g., after changing boundary conditions).
+
+    */
+
+    // clear history
+    anderson_count = 0;
+    anderson_col = 0;
+    anderson_dg_mat = Eigen::MatrixXd::Zero(num_equation, num_anderson);
+    anderson_df_mat = Eigen::MatrixXd::Zero(num_equation, num_anderson);
+    anderson_g_last_vec = Eigen::VectorXd::Zero(num_equation);
+    anderson_f_last_vec = Eigen::VectorXd::Zero(num_equation);
+
+}
+
+void MatrixEquationSteady::accelerate_solution()
+{
+
+    // get fixed-point value and residual
+    // x_vec holds the solution of Ax = b and x_iterate_vec the x used to fill up A and b
+    Eigen::VectorXd f_vec = x_vec - x_iterate_vec;
+
+    // store differences from last iterate
+    if (anderson_count > 0)
+    {
+        anderson_dg_mat.col(anderson_col) = x_vec - anderson_g_last_vec;
+        anderson_df_mat.col(anderson_col) = f_vec - anderson_f_last_vec;
+        anderson_col = (anderson_col + 1) % num_anderson;
+    }
+    anderson_g_last_vec = x_vec;
+    anderson_f_last_vec = f_vec;
+    anderson_count++;
+
+    // skip mixing if there are no differences yet
+    // order of columns does not matter in the least squares problem
+    int num_col = std::min(anderson_count - 1, num_anderson);
+    if (num_col == 0)
     {
+        return;
+    }
 
-        // get starting row
-        // note: column in a_mat = row in x_vec
-        int start_row = variable_field_ptr->start_col;
+    // solve least squares problem and mix iterates
+    // complete orthogonal decomposition handles nearly dependent columns
+    Eigen::VectorXd gamma_vec = anderson_df_mat.leftCols(num_col).completeOrthogonalDecomposition().solve(f_vec);
+    x_vec -= anderson_dg_mat.leftCols(num_col)*gamma_vec;
 
-        // iterate through each variable
-        for (auto variable_ptr : variable_field_ptr->variable_l2_ptr_vec)
-        {
+}
 
-            // iterate through each global ID
-            for (auto point_gid : variable_ptr->mesh_ptr->point_gid_vec)
-            {
+void MatrixEquationSteady::set_condensed(bool is_condensed_in)
+{
+    /*
+    
+    Sets whether unknowns with value BCs are removed from the system that is solved.
 
-                // get domain and field IDs
-                int point_fid = variable_field_ptr->point_gid_to_fid_map[point_gid];
-                int point_did = variable_ptr->mesh_ptr->point_gid_to_did_map[point_gid];
+    Arguments
+    =========
+    is_condensed_in : bool
+        true if unknowns with value BCs are removed.
 
-                // get value from x_vec
-                int vec_row = start_row + point_fid;
-                double value = x_vec.coeffRef(vec_row);
+    Returns
+    =======
+    (none)
 
-                // store value in variable
-                variable_ptr->point_value_vec[point_did] = value;
+    Notes
+    =====
+    The physics still fill up the full A and b; the rows of value BCs then read a_ii * x_i = b_i.
+    These unknowns are set to b_i / a_ii, and their columns are moved to the right-hand side of the free unknowns.
+    Only the condensed system is factorized, which is smaller and has no identity rows.
+    The positions of entries in the condensed system are precomputed here from the sparsity pattern of A.
 
-            }
+    */
+
+    // clear condensed system
+    is_condensed = is_condensed_in;
+    free_row_vec.clear();
+    constrained_row_vec.clear();
+    constrained_mat_slot_vec.clear();
+    free_mat_slot_vec.clear();
+    coupling_mat_slot_vec.clear();
+    coupling_row_vec.clear();
+    coupling_col_vec.clear();
+    if (!is_condensed)
+    {
+        return;
+    }
 
+    // mark unknowns with value BCs
+    // rows of physics and columns of variables are assigned the same starting numbers
+    std::vector<bool> is_constrained_vec(num_equation, false);
+    for (auto physics_ptr : physics_ptr_vec){
+    for (auto mat_row : physics_ptr->get_value_row_vec()){
+        is_constrained_vec[mat_row] = true;
+    }}
+
+    // number free unknowns
+    VectorInt free_row_inverse_vec(num_equation, -1);  // key: row in A; value: row in condensed system
+    for (int mat_row = 0; mat_row < num_equation; mat_row++)
+    {
+        if (is_constrained_vec[mat_row])
+        {
+            constrained_row_vec.push_back(mat_row);
+        }
+        else
+        {
+            free_row_inverse_vec[mat_row] = free_row_vec.size();
+            free_row_vec.push_back(mat_row);
+        }
+    }
+    int num_free = free_row_vec.size();
+
+    // sort entries of A into the condensed system, the coupling to constrained unknowns, and the diagonals of constrained unknowns
+    // columns are visited in order, so entries of the condensed system are found in the order of its compressed storage
+    VectorTriplet a_free_triplet_vec;
+    VectorInt constrained_mat_slot_full_vec(num_equation, -1);
+    for (int mat_col = 0; mat_col < a_mat.outerSize(); mat_col++){
+    for (int mat_slot = a_mat.outerIndexPtr()[mat_col]; mat_slot < a_mat.outerIndexPtr()[mat_col + 1]; mat_slot++){
+        int mat_row = a_mat.innerIndexPtr()[mat_slot];
+        if (is_constrained_vec[mat_row])
+        {
+            if (mat_row == mat_col)
+            {
+                constrained_mat_slot_full_vec[mat_row] = mat_slot;
+            }
         }
+        else if (is_constrained_vec[mat_col])
+        {
+            coupling_mat_slot_vec.push_back(mat_slot);
+            coupling_row_vec.push_back(free_row_inverse_vec[mat_row]);
+            coupling_col_vec.push_back(mat_col);
+        }
+        else
+        {
+            a_free_triplet_vec.emplace_back(free_row_inverse_vec[mat_row], free_row_inverse_vec[mat_col], 0.);
+            free_mat_slot_vec.push_back(mat_slot);
+        }
+    }}
+    for (auto mat_row : constrained_row_vec)
+    {
+        constrained_mat_slot_vec.push_back(constrained_mat_slot_full_vec[mat_row]);
+    }
+
+    // generate condensed system
+    a_free_mat = Eigen::SparseMatrix<double> (num_free, num_free);
+    a_free_mat.setFromTriplets(a_free_triplet_vec.begin(), a_free_triplet_vec.end());
+    a_free_mat.makeCompressed();
+    b_free_vec = Eigen::VectorXd::Zero(num_free);
+    x_free_vec = Eigen::VectorXd::Zero(num_free);
+
+}
+
+void MatrixEquationSteady::solve_condensed(MatrixSolverBase *solver_use_ptr)
+{
+
+    // get storage of full and condensed systems
+    const double *a_value_ptr = a_mat.valuePtr();
+    const double *b_value_ptr = b_vec.data();
+    double *x_value_ptr = x_vec.data();
+    double *a_free_value_ptr = a_free_mat.valuePtr();
+    double *b_free_value_ptr = b_free_vec.data();
+    double *x_free_value_ptr = x_free_vec.data();
+
+    // get number of entries
+    int num_constrained = constrained_row_vec.size();
+    int num_free_row = free_row_vec.size();
+    int num_free_mat_slot = free_mat_slot_vec.size();
+    int num_coupling = coupling_mat_slot_vec.size();
+
+    // solve for constrained unknowns
+    for (int indx_c = 0; indx_c < num_constrained; indx_c++)
+    {
+        int mat_row = constrained_row_vec[indx_c];
+        x_value_ptr[mat_row] = b_value_ptr[mat_row]/a_value_ptr[constrained_mat_slot_vec[indx_c]];
+    }
+
+    // copy entries of free unknowns
+    // x_free_vec starts from the current solution
+    for (int mat_slot = 0; mat_slot < num_free_mat_slot; mat_slot++)
+    {
+        a_free_value_ptr[mat_slot] = a_value_ptr[free_mat_slot_vec[mat_slot]];
+    }
+    for (int free_row = 0; free_row < num_free_row; free_row++)
+    {
+        b_free_value_ptr[free_row] = b_value_ptr[free_row_vec[free_row]];
+        x_free_value_ptr[free_row] = x_value_ptr[free_row_vec[free_row]];
+    }
+
+    // move columns of constrained unknowns to the right-hand side
+    for (int indx_k = 0; indx_k < num_coupling; indx_k++)
+    {
+        b_free_value_ptr[coupling_row_vec[indx_k]] -= a_value_ptr[coupling_mat_slot_vec[indx_k]]*x_value_ptr[coupling_col_vec[indx_k]];
+    }
+
+    // solve condensed system and transfer solution
+    solver_use_ptr->solve(a_free_mat, b_free_vec, x_free_vec);
+    for (int free_row = 0; free_row < num_free_row; free_row++)
+    {
+        x_value_ptr[free_row_vec[free_row]] = x_free_value_ptr[free_row];
+    }
+
+}
+
+void MatrixEquationSteady::store_solution()
+{
+    /*
+    
+    Transfers the solutions in x into variable objects.
+
+    Arguments
+    =========
+    (none)
 
+    Returns
+    =======
+    (none)
+
+    */
+
+    // iterate through each variable
+    // rows of points in x_vec are precomputed in the constructor
+    for (int indx_v = 0; indx_v < static_cast<int>(variable_ptr_vec.size()); indx_v++)
+    {
+        VariableLine2 *variable_ptr = variable_ptr_vec[indx_v];
+        const int *point_vec_row_ptr = variable_point_vec_row_vec[indx_v].data();
+        for (int point_did = 0; point_did < variable_ptr->num_point_domain; point_did++)
+        {
+            variable_ptr->point_value_vec[point_did] = x_vec[point_vec_row_ptr[point_did]];
+        }
     }
 
 }
 
+void MatrixEquationSteady::set_solver(MatrixSolverBase &solver_in)
+{
+    /*
+    
+    Sets the solver used for the matrix equation.
+
+    Arguments
+    =========
+    solver_in : MatrixSolverBase
+        Solver for the matrix equation (e.g., MatrixSolverSparseLU, MatrixSolverBanded, MatrixSolverLDLT, MatrixSolverIterative).
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    solver_ptr = &solver_in;
+
+}
+
 #endif
@@ -1,10 +1,19 @@
 #ifndef MATRIXEQUATION_TRANSIENT
 #define MATRIXEQUATION_TRANSIENT
+#include <algorithm>
+#include <cmath>
 #include <set>
+#include <string>
 #include <vector>
 #include "Eigen/Eigen"
+#include "container_triplet.hpp"
+#include "container_typedef.hpp"
+#include "controller_timestep.hpp"
+#include "matrixsolver_base.hpp"
+#include "matrixsolver_sparselu.hpp"
 #include "physicstransient_base.hpp"
 #include "variable_field.hpp"
+#include "variable_line2.hpp"
 
 class MatrixEquationTransient
 {
@@ -23,14 +32,35 @@ class MatrixEquationTransient
         Sets the current value of x(t+1) to x(t) for use in the next timestep.
     iterate_solution : void
         Solves for x in Ax = b.
-        Uses the currently stored values in A and b.
+        M, K, and f are reset and filled up by the physics in each call.
+    iterate_solution_adaptive : double
+        Solves for x in Ax = b with a timestep adjusted by a ControllerTimestep.
+    update_operator : void
+        Resets and fills up M, K, and f with each physics.
+    set_operator_constant : void
+        Sets whether M, K, and f are filled up once and reused in every timestep.
+    set_integrator : void
+        Sets the time integration scheme.
+    set_time : void
+        Sets the time of the last timestep solution x(t).
+    get_integrator_order : int
+        Returns the order of accuracy of the time integration scheme.
     store_solution : void
         Transfers the solutions in x into variable objects.
+    set_solver : void
+        Sets the solver used for the matrix equation.
 
     Notes
     =====
-    The equation Ax(t+1) = b is expanded into Ax(t+1) = Cx(t) + d for convenience.
-    In the code; A, x, C, and d are referred to as a_mat, x_vec, c_mat, and d_vec respectively.
+    The physics fill up the operators of M dx/dt + Kx = f, which do not depend on dt.
+    These are combined into A = coeff_m * M + coeff_k * K and b in each timestep or stage.
+    For backward Euler, A = M/dt + K and b = M x(t) / dt + f.
+    In the code; A, x, M, K, and f are referred to as a_mat, x_vec, m_mat, k_mat, and f_vec respectively.
+    Other time integration schemes combine the operators differently (see set_integrator).
+    The factorization of A is reused if A is unchanged since it was last factorized.
+    This is detected by comparing the values of A, or assumed without forming A if the operators are constant and dt is unchanged.
+    Time-dependent BC parameters (see BoundaryLine2::set_boundarycondition_series) are evaluated at the time of each stage of the scheme.
+    If the operators are constant, only the BC entries of K and f that changed are updated.
 
     */
 
@@ -40,18 +70,69 @@ class MatrixEquationTransient
     std::vector<PhysicsTransientBase*> physics_ptr_vec;
     std::vector<VariableField*> variable_field_ptr_vec;
 
+    // variables and their rows in x_vec
+    // row of each point at variable_point_vec_row_vec[indx_v][point_did]
+    std::vector<VariableLine2*> variable_ptr_vec;
+    std::vector<VectorInt> variable_point_vec_row_vec;
+
     // matrix equation variables
     Eigen::SparseMatrix<double> a_mat;
-    Eigen::SparseMatrix<double> c_mat;
-    Eigen::VectorXd d_vec;
+    Eigen::VectorXd b_vec;
     Eigen::VectorXd x_vec;
     Eigen::VectorXd x_last_timestep_vec;
     int num_equation = 0;
 
+    // time integration
+    // x_last2_timestep_vec is x(t-1); dt_last_timestep is the length of the timestep from x(t-1) to x(t)
+    // dt_last_timestep is 0 if there is no earlier timestep
+    std::string integrator_str = "backwardeuler";
+    Eigen::VectorXd x_last2_timestep_vec;
+    double dt_timestep = 0.;
+    double dt_last_timestep = 0.;
+    double time_last_timestep = 0.;  // time of x(t)
+
+    // operators filled up by the physics
+    // m_mat and k_mat have the same sparsity pattern as a_mat
+    Eigen::SparseMatrix<double> m_mat;
+    Eigen::SparseMatrix<double> k_mat;
+    Eigen::VectorXd f_vec;
+    Eigen::VectorXd differential_row_vec;  // 1 for rows with entries in M; 0 for algebraic rows (e.g., Dirichlet BCs)
+    bool is_operator_constant = false;
+    bool is_operator_filled = false;
+
+    // state of a_mat
+    // a_mat is current if it was formed from the operators as they are now, as coeff_m * M + coeff_k * K
+    bool is_a_mat_current = false;
+    double a_mat_coeff_m = 0.;
+    double a_mat_coeff_k = 0.;
+
+    // last factorization of a_mat
+    // values of a_mat when it was factorized; number of factorizations done by the solver afterwards
+    bool is_factorized = false;
+    VectorDouble a_mat_factorized_vec;
+    int num_factorization_solver = 0;
+
+    // work vectors
+    Eigen::VectorXd x_work_vec;
+    Eigen::VectorXd x_coarse_vec;
+    Eigen::VectorXd x_half_vec;
+
+    // solver
+    // sparse LU is used unless another solver is set
+    MatrixSolverBase *solver_ptr = nullptr;
+    MatrixSolverSparseLU solver_sparselu;
+
     // functions
     void set_last_timestep_solution();
     void iterate_solution(double dt);
+    double iterate_solution_adaptive(double &dt, ControllerTimestep &controller);
+    void update_operator();
+    void set_operator_constant(bool is_operator_constant_in);
+    void set_integrator(std::string integrator_str_in);
+    void set_time(double time_in);
+    int get_integrator_order();
     void store_solution();
+    void set_solver(MatrixSolverBase &solver_in);
 
     // default constructor
     MatrixEquationTransient()
@@ -129,12 +210,34 @@ class MatrixEquationTransient
         variable_field_ptr_vec = std::vector<VariableField*>(variable_field_ptr_set.begin(), variable_field_ptr_set.end());
 
         // initialize matrix equation variables
-        a_mat = Eigen::SparseMatrix<double> (num_equation, num_equation);
-        c_mat = Eigen::SparseMatrix<double> (num_equation, num_equation);
-        d_vec = Eigen::VectorXd::Zero(num_equation);
+        b_vec = Eigen::VectorXd::Zero(num_equation);
+        f_vec = Eigen::VectorXd::Zero(num_equation);
+        differential_row_vec = Eigen::VectorXd::Ones(num_equation);
+        x_work_vec = Eigen::VectorXd::Zero(num_equation);
         x_vec = Eigen::VectorXd::Zero(num_equation);
         
-        // populate x_vec with initial values
+        // generate sparsity pattern of a_mat
+        // each physics adds the entries that it fills up
+        VectorTriplet a_triplet_vec;
+        for (auto physics_ptr : physics_ptr_vec)
+        {
+            physics_ptr->matrix_pattern(a_triplet_vec);
+        }
+        a_mat = Eigen::SparseMatrix<double> (num_equation, num_equation);
+        a_mat.setFromTriplets(a_triplet_vec.begin(), a_triplet_vec.end());
+        a_mat.makeCompressed();
+        m_mat = a_mat;
+        k_mat = a_mat;
+
+        // store positions of entries in the compressed storage of a_mat
+        // physics use these to fill up a_mat without searching for entries
+        for (auto physics_ptr : physics_ptr_vec)
+        {
+            physics_ptr->set_matrix_slot(a_mat);
+        }
+        
+        // generate rows of variable points in x_vec
+        // these replace global to field ID lookups when x_vec is read or written
 
         // iterate through each variable field
         for (auto variable_field_ptr : variable_field_ptr_vec)
@@ -148,32 +251,47 @@ class MatrixEquationTransient
             for (auto variable_ptr : variable_field_ptr->variable_l2_ptr_vec)
             {
 
-                // iterate through each global ID
-                for (auto point_gid : variable_ptr->mesh_ptr->point_gid_vec)
-                {
+                // initialize rows of points in variable
+                VectorInt point_vec_row_vec(variable_ptr->num_point_domain);
 
-                    // get domain and field IDs
+                // iterate through each domain point
+                for (int point_did = 0; point_did < variable_ptr->num_point_domain; point_did++)
+                {
+                    int point_gid = variable_ptr->mesh_ptr->point_gid_vec[point_did];
                     int point_fid = variable_field_ptr->point_gid_to_fid_map[point_gid];
-                    int point_did = variable_ptr->mesh_ptr->point_gid_to_did_map[point_gid];
+                    point_vec_row_vec[point_did] = start_row + point_fid;
+                }
 
-                    // get value from variable
-                    double value = variable_ptr->point_value_vec[point_did];
+                // store variable and rows
+                variable_ptr_vec.push_back(variable_ptr);
+                variable_point_vec_row_vec.push_back(point_vec_row_vec);
 
-                    // store value in x_vec
-                    int vec_row = start_row + point_fid;
-                    x_vec.coeffRef(vec_row) = value;
+            }
 
-                }
+        }
 
+        // populate x_vec with initial values
+        for (int indx_v = 0; indx_v < static_cast<int>(variable_ptr_vec.size()); indx_v++)
+        {
+            VariableLine2 *variable_ptr = variable_ptr_vec[indx_v];
+            const int *point_vec_row_ptr = variable_point_vec_row_vec[indx_v].data();
+            for (int point_did = 0; point_did < variable_ptr->num_point_domain; point_did++)
+            {
+                x_vec[point_vec_row_ptr[point_did]] = variable_ptr->point_value_vec[point_did];
             }
-
         }
 
         // use initial values as previous values
         x_last_timestep_vec = x_vec;
+        x_last2_timestep_vec = x_vec;
 
     }
 
+    private:
+    void solve_timestep(double dt, Eigen::VectorXd &x_prev_vec, Eigen::VectorXd &x_prev2_vec, double dt_prev, double time_prev);
+    void solve_matrix(double coeff_m, double coeff_k);
+    void update_boundary(double time);
+
 };
 
 void MatrixEquationTransient::set_last_timestep_solution()
@@ -190,9 +308,17 @@ void MatrixEquationTransient::set_last_timestep_solution()
     =======
     (none)
 
+    Notes
+    =====
+    x(t) and the length of the last timestep are also kept for multistep schemes.
+    The time of x(t) is advanced by the length of the timestep.
+
     */
 
+    x_last2_timestep_vec = x_last_timestep_vec;
     x_last_timestep_vec = x_vec;
+    dt_last_timestep = dt_timestep;
+    time_last_timestep += dt_timestep;
 
 }
 
@@ -201,7 +327,7 @@ void MatrixEquationTransient::iterate_solution(double dt)
     /*
     
     Solves for x in Ax = b.
-    Uses the currently stored values in A and b.
+    M, K, and f are reset and filled up by the physics in each call.
 
     Arguments
     =========
@@ -212,21 +338,426 @@ void MatrixEquationTransient::iterate_solution(double dt)
     =======
     (none)
 
+    Notes
+    =====
+    M, K, and f are only filled up in the first call if set_operator_constant(true) was called.
+    Time-dependent BC parameters are evaluated at the time of each stage of the scheme (see solve_timestep).
+
+    */
+
+    // fill up operators unless they are reused
+    if (!is_operator_constant || !is_operator_filled)
+    {
+        update_operator();
+    }
+
+    // form and solve the matrix equation
+    solve_timestep(dt, x_last_timestep_vec, x_last2_timestep_vec, dt_last_timestep, time_last_timestep);
+    dt_timestep = dt;
+
+}
+
+double MatrixEquationTransient::iterate_solution_adaptive(double &dt, ControllerTimestep &controller)
+{
+    /*
+    
+    Solves for x in Ax = b with a timestep adjusted by a ControllerTimestep.
+
+    Arguments
+    =========
+    dt : double
+        Length of the timestep to attempt.
+        Replaced with the length of the next timestep to attempt.
+    controller : ControllerTimestep
+        Controller that estimates the error and adjusts the timestep.
+
+    Returns
+    =======
+    dt_step : double
+        Length of the accepted timestep (x holds x(t + dt_step)).
+        0 if no timestep was accepted (x holds x(t)).
+
+    Notes
+    =====
+    The local error is estimated by comparing one step of dt with two steps of dt/2.
+    The solution from the two half steps is kept.
+    The change in timestep accounts for the order of the time integration scheme.
+    Rejected timesteps are retried with a shorter dt until the error is within tolerance or dt reaches dt_min.
+    Timesteps with a non-finite error are never accepted, not even at dt_min.
+    The timestep fails after controller.num_rejection_max rejections in a row; dt is then the shortened timestep to retry with.
+    Each attempt solves the matrix equation three times.
+    M, K, and f are filled up at most once per call and shared by all solves.
+    Callers that must stop at a given time should limit dt before each call.
+
     */
 
-    // fill up a_mat, c_mat, and d_vec with each physics
+    // fill up operators unless they are reused
+    // dt does not enter M, K, or f, so retries with another dt do not need them to be filled up again
+    if (!is_operator_constant || !is_operator_filled)
+    {
+        update_operator();
+    }
+
+    // get order of scheme
+    int order = get_integrator_order();
+
+    // attempt timesteps until one is accepted or too many are rejected
+    for (int num_rejection = 0; num_rejection < controller.num_rejection_max; num_rejection++)
+    {
+
+        // one step of dt
+        solve_timestep(dt, x_last_timestep_vec, x_last2_timestep_vec, dt_last_timestep, time_last_timestep);
+        x_coarse_vec = x_vec;
+
+        // two steps of dt/2
+        // the second half step has the first one as its history
+        solve_timestep(0.5*dt, x_last_timestep_vec, x_last2_timestep_vec, dt_last_timestep, time_last_timestep);
+        x_half_vec = x_vec;
+        solve_timestep(0.5*dt, x_half_vec, x_last_timestep_vec, 0.5*dt, time_last_timestep + 0.5*dt);
+
+        // estimate local error
+        double error_norm = controller.get_error_norm(x_coarse_vec, x_vec, x_last_timestep_vec);
+        double dt_step = dt;
+
+        // accept timestep if error is within tolerance
+        // timesteps at dt_min are accepted unless the solution is not finite
+        bool is_min = (controller.dt_min > 0. && dt <= controller.dt_min);
+        if (error_norm <= 1. || (is_min && std::isfinite(error_norm)))
+        {
+            controller.num_step_accepted++;
+            dt_timestep = dt_step;
+            dt = controller.get_timestep_next(dt, error_norm, order, false);
+            return dt_step;
+        }
+
+        // reject timestep and retry with shorter dt
+        controller.num_step_rejected++;
+        dt = controller.get_timestep_next(dt, error_norm, order, true);
+
+    }
+
+    // report failed timestep
+    // x is reset to x(t) so that the failed solution is not carried into the next timestep
+    x_vec = x_last_timestep_vec;
+    dt_timestep = 0.;
+    return 0.;
+
+}
+
+void MatrixEquationTransient::update_operator()
+{
+    /*
+    
+    Resets and fills up M, K, and f with each physics.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Called by iterate_solution in every timestep unless the operators are set as constant.
+    Can be called directly to refill constant operators after coefficients are changed.
+
+    */
+
+    // reset m_mat, k_mat, and f_vec
+    // values are zeroed in place so the sparsity pattern and storage are kept
+    m_mat.coeffs().setZero();
+    k_mat.coeffs().setZero();
+    f_vec.setZero();
+
+    // fill up m_mat, k_mat, and f_vec with each physics
     for (auto physics_ptr : physics_ptr_vec)
     {
-        physics_ptr->matrix_fill(a_mat, c_mat, d_vec, x_vec, x_last_timestep_vec, dt);
+        physics_ptr->matrix_fill(m_mat, k_mat, f_vec, x_vec, x_last_timestep_vec);
+    }
+    is_operator_filled = true;
+
+    // mark rows with entries in m_mat
+    // other rows are algebraic and are always treated implicitly
+    differential_row_vec.setZero();
+    const double *m_value_ptr = m_mat.valuePtr();
+    const int *m_inner_ptr = m_mat.innerIndexPtr();
+    for (int mat_slot = 0; mat_slot < m_mat.nonZeros(); mat_slot++)
+    {
+        if (m_value_ptr[mat_slot] != 0.)
+        {
+            differential_row_vec[m_inner_ptr[mat_slot]] = 1.;
+        }
+    }
+
+    // a_mat must be formed again from the new operators
+    is_a_mat_current = false;
+
+}
+
+void MatrixEquationTransient::set_operator_constant(bool is_operator_constant_in)
+{
+    /*
+    
+    Sets whether M, K, and f are filled up once and reused in every timestep.
+
+    Arguments
+    =========
+    is_operator_constant_in : bool
+        true if the coefficients of all physics are constant in time and do not depend on x.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    With constant operators and a fixed dt, A is formed and factorized only in the first timestep.
+    Each later timestep only computes M x(t) / dt + f and reuses the factorization.
+
+    */
+
+    is_operator_constant = is_operator_constant_in;
+
+}
+
+void MatrixEquationTransient::set_integrator(std::string integrator_str_in)
+{
+    /*
+    
+    Sets the time integration scheme.
+
+    Arguments
+    =========
+    integrator_str_in : string
+        "backwardeuler" (default) - first order; A = M/dt + K.
+        "bdf2" - second order backward differentiation formula with variable timesteps.
+        "cranknicolson" - second order trapezoidal rule; A = M/dt + K/2.
+        "sdirk2" - second order, two-stage, L-stable singly diagonally implicit Runge-Kutta scheme.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    bdf2 uses backward Euler in the first timestep, since there is no earlier solution yet.
+    cranknicolson is not L-stable; fast components may oscillate with large timesteps.
+    sdirk2 solves the matrix equation twice per timestep with the same A, so A is only factorized once.
+    Algebraic rows (rows without entries in M, such as Dirichlet BCs) are always treated implicitly.
+
+    */
+
+    integrator_str = integrator_str_in;
+
+}
+
+void MatrixEquationTransient::set_time(double time_in)
+{
+    /*
+    
+    Sets the time of the last timestep solution x(t).
+
+    Arguments
+    =========
+    time_in : double
+        Time of x(t).
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    The time starts at zero and is advanced in set_last_timestep_solution.
+    It is only used to evaluate time-dependent BC parameters.
+
+    */
+
+    time_last_timestep = time_in;
+
+}
+
+int MatrixEquationTransient::get_integrator_order()
+{
+    /*
+    
+    Returns the order of accuracy of the time integration scheme.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    order : int
+        Order of accuracy of the next timestep.
+
+    Notes
+    =====
+    "bdf2" falls back to backward Euler (order 1) while there is no earlier timestep (dt_last_timestep = 0).
+
+    */
+
+    if (integrator_str == "bdf2")
+    {
+        return (dt_last_timestep > 0.) ? 2 : 1;
+    }
+    if (integrator_str == "cranknicolson" || integrator_str == "sdirk2")
+    {
+        return 2;
+    }
+    return 1;
+
+}
+
+void MatrixEquationTransient::solve_timestep(double dt, Eigen::VectorXd &x_prev_vec, Eigen::VectorXd &x_prev2_vec, double dt_prev, double time_prev)
+{
+    /*
+    
+    Forms and solves the matrix equation of one timestep with the time integration scheme.
+
+    Arguments
+    =========
+    dt : double
+        Length of the timestep.
+    x_prev_vec : Eigen::VectorXd
+        x(t).
+    x_prev2_vec : Eigen::VectorXd
+        x(t-1).
+        Only used by multistep schemes.
+    dt_prev : double
+        Length of the timestep from x(t-1) to x(t).
+        0 if there is no earlier timestep.
+    time_prev : double
+        Time of x(t).
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Time-dependent BC parameters are evaluated at the time of each stage.
+    This is t + dt for bdf2 and backward Euler, t and t + dt for the explicit and implicit halves of cranknicolson,
+    and t + gamma dt and t + dt for the two stages of sdirk2.
+
+    */
+
+    // dt_inv is used to scale m_mat
+    double dt_inv = 1./dt;
+
+    // second order backward differentiation formula
+    // (1+2w)/(1+w) x(t+1) - (1+w) x(t) + w^2/(1+w) x(t-1) = dt M^-1 (f - K x(t+1)), where w = dt/dt_prev
+    if (integrator_str == "bdf2" && dt_prev > 0.)
+    {
+        update_boundary(time_prev + dt);
+        double ratio = dt/dt_prev;
+        x_work_vec = (1. + ratio)*x_prev_vec - (ratio*ratio/(1. + ratio))*x_prev2_vec;
+        b_vec.noalias() = m_mat*x_work_vec;
+        b_vec = dt_inv*b_vec + f_vec;
+        solve_matrix(dt_inv*(1. + 2.*ratio)/(1. + ratio), 1.);
+    }
+
+    // crank-nicolson
+    // (M/dt + K/2) x(t+1) = M x(t) / dt + (f - K x(t))/2 + f/2
+    // the explicit half is dropped in algebraic rows so that they are satisfied exactly
+    // K and f in the explicit half are evaluated at t
+    else if (integrator_str == "cranknicolson")
+    {
+        update_boundary(time_prev);
+        x_work_vec.noalias() = k_mat*x_prev_vec;
+        x_work_vec = differential_row_vec.cwiseProduct(f_vec - x_work_vec);
+        update_boundary(time_prev + dt);
+        b_vec.noalias() = m_mat*x_prev_vec;
+        b_vec = dt_inv*b_vec + 0.5*f_vec + 0.5*x_work_vec;
+        solve_matrix(dt_inv, 0.5);
+    }
 
+    // two-stage SDIRK with gamma = 1 - 1/sqrt(2)
+    // each stage solves (M/(gamma dt) + K) X = M y / (gamma dt) + f
+    // stage 1: y = x(t) at t + gamma dt; stage 2: y = x(t) + (1 - gamma)/gamma (X1 - x(t)) at t + dt; x(t+1) = X2
+    else if (integrator_str == "sdirk2")
+    {
+        double gamma = 1. - 1./std::sqrt(2.);
+        double gamma_dt_inv = dt_inv/gamma;
+        update_boundary(time_prev + gamma*dt);
+        b_vec.noalias() = m_mat*x_prev_vec;
+        b_vec = gamma_dt_inv*b_vec + f_vec;
+        solve_matrix(gamma_dt_inv, 1.);
+        update_boundary(time_prev + dt);
+        x_work_vec = x_prev_vec + ((1. - gamma)/gamma)*(x_vec - x_prev_vec);
+        b_vec.noalias() = m_mat*x_work_vec;
+        b_vec = gamma_dt_inv*b_vec + f_vec;
+        solve_matrix(gamma_dt_inv, 1.);
+    }
+
+    // backward euler
+    // (M/dt + K) x(t+1) = M x(t) / dt + f
+    else
+    {
+        update_boundary(time_prev + dt);
+        b_vec.noalias() = m_mat*x_prev_vec;
+        b_vec = dt_inv*b_vec + f_vec;
+        solve_matrix(dt_inv, 1.);
+    }
+
+}
+
+void MatrixEquationTransient::solve_matrix(double coeff_m, double coeff_k)
+{
+    /*
+    
+    Forms A = coeff_m * M + coeff_k * K and solves for x in Ax = b.
+
+    Arguments
+    =========
+    coeff_m : double
+        Coefficient of M in A.
+    coeff_k : double
+        Coefficient of K in A.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    b_vec must be formed before this function is called.
+
+    */
+
+    // get solver
+    // its factorization is only valid if it has not factorized another matrix since
+    MatrixSolverBase *solver_use_ptr = (solver_ptr != nullptr) ? solver_ptr : &solver_sparselu;
+    bool is_reuse = is_factorized && solver_use_ptr->num_factorization == num_factorization_solver;
+
+    // form a_mat unless neither the operators nor the coefficients have changed
+    // m_mat, k_mat, and a_mat share a sparsity pattern, so only the values are combined
+    // a newly formed a_mat can still reuse the factorization if its values are unchanged
+    if (!is_a_mat_current || coeff_m != a_mat_coeff_m || coeff_k != a_mat_coeff_k)
+    {
+        a_mat.coeffs() = coeff_k*k_mat.coeffs() + coeff_m*m_mat.coeffs();
+        is_a_mat_current = true;
+        a_mat_coeff_m = coeff_m;
+        a_mat_coeff_k = coeff_k;
+        is_reuse = is_reuse && std::equal(a_mat_factorized_vec.begin(), a_mat_factorized_vec.end(), a_mat.valuePtr());
     }
 
     // solve the matrix equation
-    // b_vec = c_mat*x_last_timestep_vec + d_vec
-    Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> solver;
-    solver.analyzePattern(a_mat);
-    solver.factorize(a_mat);
-    x_vec = solver.solve(c_mat*x_last_timestep_vec + d_vec);
+    // reuse the factorization if a_mat is unchanged
+    if (is_reuse)
+    {
+        solver_use_ptr->solve_factorized(a_mat, b_vec, x_vec);
+        return;
+    }
+    solver_use_ptr->solve(a_mat, b_vec, x_vec);
+
+    // store values of factorized a_mat
+    a_mat_factorized_vec.assign(a_mat.valuePtr(), a_mat.valuePtr() + a_mat.nonZeros());
+    num_factorization_solver = solver_use_ptr->num_factorization;
+    is_factorized = true;
 
 }
 
@@ -246,37 +777,85 @@ void MatrixEquationTransient::store_solution()
 
     */
 
-    // iterate through each variable field
-    for (auto variable_field_ptr : variable_field_ptr_vec)
+    // iterate through each variable
+    // rows of points in x_vec are precomputed in the constructor
+    for (int indx_v = 0; indx_v < static_cast<int>(variable_ptr_vec.size()); indx_v++)
     {
+        VariableLine2 *variable_ptr = variable_ptr_vec[indx_v];
+        const int *point_vec_row_ptr = variable_point_vec_row_vec[indx_v].data();
+        for (int point_did = 0; point_did < variable_ptr->num_point_domain; point_did++)
+        {
+            variable_ptr->point_value_vec[point_did] = x_vec[point_vec_row_ptr[point_did]];
+        }
+    }
 
-        // get starting row
-        // note: column in a_mat = row in x_vec
-        int start_row = variable_field_ptr->start_col;
+}
 
-        // iterate through each variable
-        for (auto variable_ptr : variable_field_ptr->variable_l2_ptr_vec)
-        {
+void MatrixEquationTransient::set_solver(MatrixSolverBase &solver_in)
+{
+    /*
+    
+    Sets the solver used for the matrix equation.
 
-            // iterate through each global ID
-            for (auto point_gid : variable_ptr->mesh_ptr->point_gid_vec)
-            {
+    Arguments
+    =========
+    solver_in : MatrixSolverBase
+        Solver for the matrix equation (e.g., MatrixSolverSparseLU, MatrixSolverBanded, MatrixSolverLDLT, MatrixSolverIterative).
 
-                // get domain and field IDs
-                int point_fid = variable_field_ptr->point_gid_to_fid_map[point_gid];
-                int point_did = variable_ptr->mesh_ptr->point_gid_to_did_map[point_gid];
+    Returns
+    =======
+    (none)
 
-                // get value from x_vec
-                int vec_row = start_row + point_fid;
-                double value = x_vec.coeffRef(vec_row);
+    */
 
-                // store value in variable
-                variable_ptr->point_value_vec[point_did] = value;
+    solver_ptr = &solver_in;
+    is_factorized = false;
 
-            }
+}
 
-        }
+void MatrixEquationTransient::update_boundary(double time)
+{
+    /*
+    
+    Evaluates time-dependent BC parameters at a given time and updates the operators.
+
+    Arguments
+    =========
+    time : double
+        Time at which the BC parameters are evaluated.
 
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Called by solve_timestep before each stage, at the time of that stage.
+    Only the BC entries of K and f are refilled (see PhysicsTransientBase::matrix_fill_boundary); M is unaffected.
+    A is formed again in the next solve if any BC entry changed.
+    Nothing is done if no BC parameter changed or the operators have not been filled up yet.
+
+    */
+
+    // evaluate time-dependent BC parameters of each physics
+    bool is_changed = false;
+    for (auto physics_ptr : physics_ptr_vec){
+    for (auto boundary_ptr : physics_ptr->get_boundary_field_ptr()->boundary_l2_ptr_vec){
+        is_changed = boundary_ptr->update_boundarycondition(time) || is_changed;
+    }}
+
+    // update only the changed BC entries of filled operators
+    // operators that are filled up afterwards already include the changes
+    if (!is_changed || !is_operator_filled)
+    {
+        return;
+    }
+    for (auto physics_ptr : physics_ptr_vec)
+    {
+        if (physics_ptr->matrix_fill_boundary(k_mat, f_vec))
+        {
+            is_a_mat_current = false;
+        }
     }
 
 }
@@ -0,0 +1,463 @@
+#ifndef MATRIXSOLVER_BANDED
+#define MATRIXSOLVER_BANDED
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "Eigen/Eigen"
+#include "container_typedef.hpp"
+#include "matrixsolver_base.hpp"
+#include "matrixsolver_sparselu.hpp"
+
+class MatrixSolverBanded : public MatrixSolverBase
+{
+    /*
+
+    Solves the matrix equation Ax = b using a banded LU decomposition with partial pivoting.
+
+    Variables
+    =========
+    max_bandwidth_in : int
+        Largest bandwidth (number of lower + upper diagonals) that is solved with the banded algorithm.
+        Matrices with larger bandwidths are solved with a sparse LU decomposition instead.
+
+    Functions
+    =========
+    solve : void
+        Solves for x in Ax = b.
+    solve_factorized : void
+        Solves for x in Ax = b reusing the factorization of A from the last call to solve.
+
+    Notes
+    =====
+    The unknowns are reordered with the Cuthill-McKee algorithm when the sparsity pattern of A changes.
+    Matrices assembled from line2 elements become tridiagonal (or narrowly banded if variables are coupled) after reordering.
+    Factorization and solution are then O(n) in time and memory.
+    If A is singular (zero pivot), x is left unchanged and get_is_converged returns false.
+
+    */
+
+    public:
+
+    // largest bandwidth solved with banded algorithm
+    int max_bandwidth = 32;
+
+    // reordering of unknowns
+    int num_equation = 0;
+    VectorInt perm_vec;  // key: reordered ID; value: original ID
+    VectorInt perm_inverse_vec;  // key: original ID; value: reordered ID
+
+    // banded storage
+    // entry (i, j) of the reordered matrix is stored in band_vec[i*num_band_col + j - i + num_lower]
+    bool is_banded = false;
+    int num_lower = 0;  // number of lower diagonals
+    int num_upper = 0;  // number of upper diagonals
+    int num_band_col = 0;  // number of lower + upper diagonals after pivoting
+    VectorInt band_index_vec;  // key: index of nonzero in A; value: index in band_vec
+    VectorDouble band_vec;
+    VectorDouble lower_vec;  // multipliers of L
+    VectorInt pivot_vec;  // row swapped with each row during pivoting
+    VectorDouble rhs_vec;
+
+    // fallback for matrices with large bandwidths
+    MatrixSolverSparseLU solver_fallback;
+
+    // functions
+    void solve(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec);
+    void solve_factorized(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec);
+
+    // default constructor
+    MatrixSolverBanded()
+    {
+
+    }
+
+    // constructor
+    MatrixSolverBanded(int max_bandwidth_in)
+    {
+        max_bandwidth = max_bandwidth_in;
+    }
+
+    private:
+    void analyze_pattern(Eigen::SparseMatrix<double> &a_mat);
+    bool factorize(Eigen::SparseMatrix<double> &a_mat);
+    void substitute(Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec);
+
+};
+
+void MatrixSolverBanded::solve(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec)
+{
+    /*
+
+    Solves for x in Ax = b.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+    x_vec : Eigen::VectorXd
+        x in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    // reorder and determine bandwidth if the sparsity pattern of a_mat changes
+    a_mat.makeCompressed();
+    if (is_pattern_changed(a_mat))
+    {
+        analyze_pattern(a_mat);
+    }
+
+    // use sparse LU if bandwidth is too large
+    num_factorization++;
+    if (!is_banded)
+    {
+        solver_fallback.solve(a_mat, b_vec, x_vec);
+        is_converged = solver_fallback.is_converged;
+        return;
+    }
+
+    // factorize reordered matrix and solve
+    // x_vec is left unchanged if a zero pivot is found
+    is_converged = factorize(a_mat);
+    if (!is_converged)
+    {
+        return;
+    }
+    substitute(b_vec, x_vec);
+
+}
+
+void MatrixSolverBanded::solve_factorized(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec)
+{
+    /*
+
+    Solves for x in Ax = b reusing the factorization of A from the last call to solve.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+        Must be the same matrix (pattern and values) as in the last call to solve.
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+    x_vec : Eigen::VectorXd
+        x in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    // use sparse LU if bandwidth is too large
+    if (!is_banded)
+    {
+        solver_fallback.solve_factorized(a_mat, b_vec, x_vec);
+        is_converged = solver_fallback.is_converged;
+        return;
+    }
+
+    // only the substitutions are done
+    // skipped if the last factorization failed
+    if (!is_converged)
+    {
+        return;
+    }
+    substitute(b_vec, x_vec);
+
+}
+
+void MatrixSolverBanded::substitute(Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec)
+{
+    /*
+
+    Solves for x in Ax = b using the banded LU decomposition of A.
+
+    Arguments
+    =========
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+    x_vec : Eigen::VectorXd
+        x in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    // reorder right-hand side
+    double *rhs_ptr = rhs_vec.data();
+    for (int indx_orig = 0; indx_orig < num_equation; indx_orig++)
+    {
+        rhs_ptr[perm_inverse_vec[indx_orig]] = b_vec.coeff(indx_orig);
+    }
+
+    // forward substitution with row swaps and L
+    for (int indx_k = 0; indx_k < num_equation; indx_k++)
+    {
+        int pivot_row = pivot_vec[indx_k];
+        if (pivot_row != indx_k)
+        {
+            std::swap(rhs_ptr[indx_k], rhs_ptr[pivot_row]);
+        }
+        int row_last = std::min(num_equation - 1, indx_k + num_lower);
+        const double *lower_ptr = lower_vec.data() + indx_k*num_lower;  // lower_vec is empty if num_lower is 0
+        for (int indx_i = indx_k + 1; indx_i <= row_last; indx_i++)
+        {
+            rhs_ptr[indx_i] -= lower_ptr[indx_i - indx_k - 1]*rhs_ptr[indx_k];
+        }
+    }
+
+    // backward substitution with U
+    for (int indx_i = num_equation - 1; indx_i >= 0; indx_i--)
+    {
+        int col_last = std::min(num_equation - 1, indx_i + num_lower + num_upper);
+        const double *band_row_ptr = &band_vec[indx_i*num_band_col - indx_i + num_lower];  // indexed with column
+        double value = rhs_ptr[indx_i];
+        for (int indx_j = indx_i + 1; indx_j <= col_last; indx_j++)
+        {
+            value -= band_row_ptr[indx_j]*rhs_ptr[indx_j];
+        }
+        rhs_ptr[indx_i] = value/band_row_ptr[indx_i];
+    }
+
+    // undo reordering
+    x_vec.resize(num_equation);
+    for (int indx_orig = 0; indx_orig < num_equation; indx_orig++)
+    {
+        x_vec.coeffRef(indx_orig) = rhs_ptr[perm_inverse_vec[indx_orig]];
+    }
+
+}
+
+void MatrixSolverBanded::analyze_pattern(Eigen::SparseMatrix<double> &a_mat)
+{
+    /*
+
+    Reorders the unknowns to minimize the bandwidth and generates the banded storage.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    // get compressed storage of a_mat
+    num_equation = a_mat.rows();
+    int num_nonzero = a_mat.nonZeros();
+    const int *outer_index_ptr = a_mat.outerIndexPtr();
+    const int *inner_index_ptr = a_mat.innerIndexPtr();
+
+    // generate adjacency of (A + A^T)
+    std::vector<VectorInt> adjacency_vec(num_equation);
+    for (int col = 0; col < num_equation; col++){
+    for (int indx_nz = outer_index_ptr[col]; indx_nz < outer_index_ptr[col + 1]; indx_nz++){
+        int row = inner_index_ptr[indx_nz];
+        if (row != col)
+        {
+            adjacency_vec[row].push_back(col);
+            adjacency_vec[col].push_back(row);
+        }
+    }}
+    for (auto &adjacency_part_vec : adjacency_vec)
+    {
+        std::sort(adjacency_part_vec.begin(), adjacency_part_vec.end());
+        adjacency_part_vec.erase(std::unique(adjacency_part_vec.begin(), adjacency_part_vec.end()), adjacency_part_vec.end());
+    }
+
+    // reorder with Cuthill-McKee
+    // each disconnected part (e.g., uncoupled variables) starts at its point of lowest degree
+    perm_vec.clear();
+    perm_vec.reserve(num_equation);
+    std::vector<bool> is_visited_vec(num_equation, false);
+    VectorInt neighbor_vec;
+    while (static_cast<int>(perm_vec.size()) < num_equation)
+    {
+
+        // get unvisited point with lowest degree
+        int start = -1;
+        for (int indx = 0; indx < num_equation; indx++)
+        {
+            if (!is_visited_vec[indx] && (start == -1 || adjacency_vec[indx].size() < adjacency_vec[start].size()))
+            {
+                start = indx;
+            }
+        }
+
+        // breadth-first search
+        // perm_vec is used as the queue
+        int indx_head = perm_vec.size();
+        perm_vec.push_back(start);
+        is_visited_vec[start] = true;
+        while (indx_head < static_cast<int>(perm_vec.size()))
+        {
+
+            // get unvisited neighbors
+            int indx_curr = perm_vec[indx_head];
+            indx_head++;
+            neighbor_vec.clear();
+            for (auto indx_next : adjacency_vec[indx_curr])
+            {
+                if (!is_visited_vec[indx_next])
+                {
+                    neighbor_vec.push_back(indx_next);
+                    is_visited_vec[indx_next] = true;
+                }
+            }
+
+            // add neighbors in order of increasing degree
+            std::sort(neighbor_vec.begin(), neighbor_vec.end(), [&](int indx_a, int indx_b) {
+                return adjacency_vec[indx_a].size() < adjacency_vec[indx_b].size();
+            });
+            perm_vec.insert(perm_vec.end(), neighbor_vec.begin(), neighbor_vec.end());
+
+        }
+
+    }
+
+    // generate inverse of reordering
+    perm_inverse_vec = VectorInt(num_equation);
+    for (int indx_new = 0; indx_new < num_equation; indx_new++)
+    {
+        perm_inverse_vec[perm_vec[indx_new]] = indx_new;
+    }
+
+    // get bandwidth of reordered matrix
+    num_lower = 0;
+    num_upper = 0;
+    for (int col = 0; col < num_equation; col++){
+    for (int indx_nz = outer_index_ptr[col]; indx_nz < outer_index_ptr[col + 1]; indx_nz++){
+        int row_new = perm_inverse_vec[inner_index_ptr[indx_nz]];
+        int col_new = perm_inverse_vec[col];
+        num_lower = std::max(num_lower, row_new - col_new);
+        num_upper = std::max(num_upper, col_new - row_new);
+    }}
+
+    // check if banded algorithm should be used
+    is_banded = (num_lower + num_upper <= max_bandwidth);
+    if (!is_banded)
+    {
+        return;
+    }
+
+    // map nonzeros in a_mat to banded storage
+    // pivoting can add up to num_lower diagonals above the upper diagonals
+    num_band_col = 2*num_lower + num_upper + 1;
+    band_index_vec = VectorInt(num_nonzero);
+    for (int col = 0; col < num_equation; col++){
+    for (int indx_nz = outer_index_ptr[col]; indx_nz < outer_index_ptr[col + 1]; indx_nz++){
+        int row_new = perm_inverse_vec[inner_index_ptr[indx_nz]];
+        int col_new = perm_inverse_vec[col];
+        band_index_vec[indx_nz] = row_new*num_band_col + col_new - row_new + num_lower;
+    }}
+
+    // allocate storage for factorization
+    band_vec = VectorDouble(num_equation*num_band_col, 0.);
+    lower_vec = VectorDouble(num_equation*num_lower, 0.);
+    pivot_vec = VectorInt(num_equation, 0);
+    rhs_vec = VectorDouble(num_equation, 0.);
+
+}
+
+bool MatrixSolverBanded::factorize(Eigen::SparseMatrix<double> &a_mat)
+{
+    /*
+
+    Computes the banded LU decomposition with partial pivoting.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+
+    Returns
+    =======
+    is_factorized : bool
+        false if a zero pivot is found (A is singular).
+
+    */
+
+    // scatter values of a_mat into banded storage
+    std::fill(band_vec.begin(), band_vec.end(), 0.);
+    const double *value_ptr = a_mat.valuePtr();
+    int num_nonzero = a_mat.nonZeros();
+    for (int indx_nz = 0; indx_nz < num_nonzero; indx_nz++)
+    {
+        band_vec[band_index_vec[indx_nz]] += value_ptr[indx_nz];
+    }
+
+    // gaussian elimination
+    // band_row_ptr[j] refers to entry (i, j) of row i
+    double *band_ptr = band_vec.data();
+    for (int indx_k = 0; indx_k < num_equation; indx_k++)
+    {
+
+        // get last row and column affected by this step
+        int row_last = std::min(num_equation - 1, indx_k + num_lower);
+        int col_last = std::min(num_equation - 1, indx_k + num_lower + num_upper);
+
+        // find pivot
+        int pivot_row = indx_k;
+        double pivot_abs = std::fabs(band_ptr[indx_k*num_band_col + num_lower]);
+        for (int indx_i = indx_k + 1; indx_i <= row_last; indx_i++)
+        {
+            double value_abs = std::fabs(band_ptr[indx_i*num_band_col + indx_k - indx_i + num_lower]);
+            if (value_abs > pivot_abs)
+            {
+                pivot_row = indx_i;
+                pivot_abs = value_abs;
+            }
+        }
+        pivot_vec[indx_k] = pivot_row;
+        if (pivot_abs == 0.)
+        {
+            return false;
+        }
+
+        // swap rows
+        double *band_k_ptr = band_ptr + indx_k*num_band_col - indx_k + num_lower;
+        if (pivot_row != indx_k)
+        {
+            double *band_pivot_ptr = band_ptr + pivot_row*num_band_col - pivot_row + num_lower;
+            for (int indx_j = indx_k; indx_j <= col_last; indx_j++)
+            {
+                std::swap(band_k_ptr[indx_j], band_pivot_ptr[indx_j]);
+            }
+        }
+
+        // eliminate entries below pivot
+        double *lower_ptr = lower_vec.data() + indx_k*num_lower;  // lower_vec is empty if num_lower is 0
+        for (int indx_i = indx_k + 1; indx_i <= row_last; indx_i++)
+        {
+            double *band_i_ptr = band_ptr + indx_i*num_band_col - indx_i + num_lower;
+            double multiplier = band_i_ptr[indx_k]/band_k_ptr[indx_k];
+            lower_ptr[indx_i - indx_k - 1] = multiplier;
+            band_i_ptr[indx_k] = 0.;
+            if (multiplier == 0.)
+            {
+                continue;
+            }
+            for (int indx_j = indx_k + 1; indx_j <= col_last; indx_j++)
+            {
+                band_i_ptr[indx_j] -= multiplier*band_k_ptr[indx_j];
+            }
+        }
+
+    }
+
+    return true;
+
+}
+
+#endif
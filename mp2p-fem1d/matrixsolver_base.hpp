@@ -0,0 +1,232 @@
+#ifndef MATRIXSOLVER_BASE
+#define MATRIXSOLVER_BASE
+#include <algorithm>
+#include <cmath>
+#include "Eigen/Eigen"
+#include "container_typedef.hpp"
+
+class MatrixSolverBase
+{
+    /*
+
+    Base class for solvers of the matrix equation Ax = b.
+
+    Functions
+    =========
+    solve : void
+        Solves for x in Ax = b.
+    solve_factorized : void
+        Solves for x in Ax = b reusing the factorization of A from the last call to solve.
+    get_is_converged : bool
+        Returns true if the last solution succeeded.
+
+    Notes
+    =====
+    solve must be implemented by each solver; x holds the previous solution on input and the new solution on output.
+    Solvers are expected to keep any reusable data (e.g., orderings, factorizations) between calls.
+    is_pattern_changed can be used to detect when this data must be regenerated.
+    is_symmetric can be used by solvers that require a symmetric A.
+    num_factorization is incremented in each call to solve.
+    Callers can compare it with a stored count to check that no other matrix was factorized in between.
+    Solvers set is_converged to false if the last solution failed (e.g., A is singular or iterations did not converge).
+    x is then left unchanged or at the last iterate.
+
+    */
+
+    public:
+
+    // sparsity pattern of A used in the last analysis
+    VectorInt a_mat_outer_index_vec;
+    VectorInt a_mat_inner_index_vec;
+
+    // number of factorizations done by this solver
+    int num_factorization = 0;
+
+    // result of last solution
+    bool is_converged = false;
+
+    // functions
+    virtual void solve(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec) = 0;
+    virtual void solve_factorized(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec);
+    bool get_is_converged();
+
+    // default constructor
+    MatrixSolverBase()
+    {
+
+    }
+
+    // destructor
+    // solvers are used through pointers to this class (e.g., in MatrixEquationSteady)
+    virtual ~MatrixSolverBase()
+    {
+
+    }
+
+    protected:
+    bool is_pattern_changed(Eigen::SparseMatrix<double> &a_mat);
+    bool is_symmetric(Eigen::SparseMatrix<double> &a_mat);
+
+};
+
+void MatrixSolverBase::solve_factorized(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec)
+{
+    /*
+
+    Solves for x in Ax = b reusing the factorization of A from the last call to solve.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+        Must be the same matrix (pattern and values) as in the last call to solve.
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+    x_vec : Eigen::VectorXd
+        x in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Solvers that do not keep a factorization solve the full system again.
+
+    */
+
+    solve(a_mat, b_vec, x_vec);
+
+}
+
+bool MatrixSolverBase::get_is_converged()
+{
+    /*
+
+    Returns true if the last solution succeeded.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    is_converged : bool
+        true if the last call to solve or solve_factorized produced a solution.
+
+    */
+
+    return is_converged;
+
+}
+
+bool MatrixSolverBase::is_pattern_changed(Eigen::SparseMatrix<double> &a_mat)
+{
+    /*
+    
+    Checks if the sparsity pattern of A differs from the one used in the last analysis.
+    Stores the current pattern if it has changed.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+
+    Returns
+    =======
+    is_changed : bool
+        true if the pattern has changed or has not been analyzed yet.
+
+    Notes
+    =====
+    A must be in compressed form before this function is called.
+
+    */
+
+    // get compressed storage of a_mat
+    int num_outer_index = a_mat.outerSize() + 1;
+    int num_inner_index = a_mat.nonZeros();
+    const int *outer_index_ptr = a_mat.outerIndexPtr();
+    const int *inner_index_ptr = a_mat.innerIndexPtr();
+
+    // compare with stored pattern
+    bool is_changed = (
+        static_cast<int>(a_mat_outer_index_vec.size()) != num_outer_index ||
+        static_cast<int>(a_mat_inner_index_vec.size()) != num_inner_index ||
+        !std::equal(a_mat_outer_index_vec.begin(), a_mat_outer_index_vec.end(), outer_index_ptr) ||
+        !std::equal(a_mat_inner_index_vec.begin(), a_mat_inner_index_vec.end(), inner_index_ptr)
+    );
+
+    // store new pattern
+    if (is_changed)
+    {
+        a_mat_outer_index_vec.assign(outer_index_ptr, outer_index_ptr + num_outer_index);
+        a_mat_inner_index_vec.assign(inner_index_ptr, inner_index_ptr + num_inner_index);
+    }
+
+    return is_changed;
+
+}
+
+bool MatrixSolverBase::is_symmetric(Eigen::SparseMatrix<double> &a_mat)
+{
+    /*
+    
+    Checks if A is symmetric.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+
+    Returns
+    =======
+    is_symmetric : bool
+        true if A_ij = A_ji for all entries within a tolerance.
+
+    Notes
+    =====
+    A must be in compressed form before this function is called.
+    The tolerance is relative to the largest absolute value in A.
+    Entries outside the sparsity pattern are taken as zero, so A need not have a symmetric pattern.
+
+    */
+
+    // get compressed storage of a_mat
+    int num_col = a_mat.outerSize();
+    const int *outer_index_ptr = a_mat.outerIndexPtr();
+    const int *inner_index_ptr = a_mat.innerIndexPtr();
+    const double *value_ptr = a_mat.valuePtr();
+
+    // get tolerance
+    double value_max = (a_mat.nonZeros() > 0) ? a_mat.coeffs().cwiseAbs().maxCoeff() : 0.;
+    double tolerance = 1e-12*value_max;
+
+    // compare each entry with its transpose
+    for (int mat_col = 0; mat_col < num_col; mat_col++){
+    for (int mat_slot = outer_index_ptr[mat_col]; mat_slot < outer_index_ptr[mat_col + 1]; mat_slot++){
+
+        // search for transpose entry in column mat_row (rows are sorted in compressed storage)
+        int mat_row = inner_index_ptr[mat_slot];
+        const int *inner_start_ptr = inner_index_ptr + outer_index_ptr[mat_row];
+        const int *inner_end_ptr = inner_index_ptr + outer_index_ptr[mat_row + 1];
+        const int *inner_ptr = std::lower_bound(inner_start_ptr, inner_end_ptr, mat_col);
+        double value_transpose = 0.;
+        if (inner_ptr != inner_end_ptr && *inner_ptr == mat_col)
+        {
+            value_transpose = value_ptr[inner_ptr - inner_index_ptr];
+        }
+
+        // compare values
+        if (std::abs(value_ptr[mat_slot] - value_transpose) > tolerance)
+        {
+            return false;
+        }
+
+    }}
+
+    return true;
+
+}
+
+#endif
@@ -0,0 +1,352 @@
+#ifndef MATRIXSOLVER_ITERATIVE
+#define MATRIXSOLVER_ITERATIVE
+#include <algorithm>
+#include <string>
+#include "Eigen/Eigen"
+#include "matrixsolver_base.hpp"
+#include "matrixsolver_sparselu.hpp"
+
+class MatrixSolverIterative : public MatrixSolverBase
+{
+    /*
+
+    Solves the matrix equation Ax = b using a preconditioned Krylov method.
+
+    Variables
+    =========
+    method_str_in : string
+        Krylov method ("cg" or "bicgstab").
+    preconditioner_str_in : string
+        Preconditioner ("jacobi" or "incomplete").
+    tolerance_in : double
+        Relative tolerance of the residual |Ax - b|/|b|.
+    max_iteration_in : int
+        Largest number of iterations (<= 0 for twice the number of equations).
+
+    Functions
+    =========
+    solve : void
+        Solves for x in Ax = b.
+    solve_factorized : void
+        Solves for x in Ax = b reusing the preconditioner of A from the last call to solve.
+    get_num_iteration : int
+        Returns the number of iterations done in the last solution.
+    get_error : double
+        Returns the relative residual of the last solution.
+    set_fallback : void
+        Sets whether systems that do not converge are solved with a sparse LU decomposition.
+
+    Notes
+    =====
+    "cg" (conjugate gradient) requires a symmetric positive definite A (e.g., diffusion with symmetric Dirichlet conditions).
+    A is checked before "cg" is used; if it is not symmetric, no iterations are done and the solution is treated as not converged.
+    "bicgstab" (biconjugate gradient stabilized) works with nonsymmetric A (e.g., convection-diffusion).
+    "incomplete" uses incomplete Cholesky with "cg" and incomplete LU with thresholding (ILUT) with "bicgstab".
+    Iterations start from the x passed in, which is the previous solution in Picard iterations and timesteps.
+    If the iterations do not converge, x is left at the last iterate and get_is_converged returns false.
+    MatrixEquationSteady::iterate_solution then returns false.
+    set_fallback(true) solves such systems with a sparse LU decomposition instead, at the cost of its memory.
+    Uses less memory than direct solvers, as no factorization of A is stored.
+    method_str and preconditioner_str can be changed between calls to solve.
+
+    */
+
+    public:
+
+    // solver settings
+    std::string method_str = "bicgstab";
+    std::string preconditioner_str = "jacobi";
+    double tolerance = 1e-10;
+    int max_iteration = 0;
+
+    // solvers
+    // only the one selected by method_str and preconditioner_str is used
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower|Eigen::Upper, Eigen::DiagonalPreconditioner<double>> solver_cg_jacobi;
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower|Eigen::Upper, Eigen::IncompleteCholesky<double>> solver_cg_incomplete;
+    Eigen::BiCGSTAB<Eigen::SparseMatrix<double>, Eigen::DiagonalPreconditioner<double>> solver_bicgstab_jacobi;
+    Eigen::BiCGSTAB<Eigen::SparseMatrix<double>, Eigen::IncompleteLUT<double>> solver_bicgstab_incomplete;
+
+    // results of last solution
+    // is_converged is kept in the base class
+    int num_iteration = 0;
+    double error = 0.;
+
+    // fallback if iterations do not converge
+    // is_fallback is true if the fallback was used in the last solution
+    bool is_fallback_enabled = false;
+    bool is_fallback = false;
+    MatrixSolverSparseLU solver_fallback;
+
+    // functions
+    void solve(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec);
+    void solve_factorized(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec);
+    int get_num_iteration();
+    double get_error();
+    void set_fallback(bool is_fallback_enabled_in);
+
+    // default constructor
+    MatrixSolverIterative()
+    {
+
+    }
+
+    // constructor
+    MatrixSolverIterative(std::string method_str_in, std::string preconditioner_str_in, double tolerance_in, int max_iteration_in)
+    {
+        method_str = method_str_in;
+        preconditioner_str = preconditioner_str_in;
+        tolerance = tolerance_in;
+        max_iteration = max_iteration_in;
+    }
+
+    private:
+
+    // solver used in the last call to solve (index in is_analyzed_arr)
+    // each solver keeps its own symbolic analysis; all are invalidated if the sparsity pattern of A changes
+    int solver_id = -1;
+    bool is_analyzed_arr[4] = {false, false, false, false};
+
+    // false if the method selected in the last call to solve cannot be used with A (e.g., "cg" with a nonsymmetric A)
+    bool is_method_valid = true;
+
+    // functions
+    void solve_selected(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec, bool is_factorized);
+    template <typename SolverType>
+    void solve_krylov(SolverType &solver, Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec, bool is_factorized);
+
+};
+
+void MatrixSolverIterative::solve(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec)
+{
+    /*
+
+    Solves for x in Ax = b.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+    x_vec : Eigen::VectorXd
+        x in Ax = b.
+        Contains the initial guess on input and the new solution on output.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    // invalidate symbolic analysis of all solvers if the sparsity pattern changed
+    a_mat.makeCompressed();
+    num_factorization++;
+    if (is_pattern_changed(a_mat))
+    {
+        std::fill(is_analyzed_arr, is_analyzed_arr + 4, false);
+    }
+
+    // select solver from current settings
+    if (method_str == "cg" && preconditioner_str == "incomplete")
+    {
+        solver_id = 0;
+    }
+    else if (method_str == "cg")
+    {
+        solver_id = 1;
+    }
+    else if (preconditioner_str == "incomplete")
+    {
+        solver_id = 2;
+    }
+    else
+    {
+        solver_id = 3;
+    }
+
+    // conjugate gradient requires a symmetric a_mat
+    is_method_valid = (solver_id > 1 || is_symmetric(a_mat));
+
+    // compute preconditioner and iterate
+    solve_selected(a_mat, b_vec, x_vec, false);
+
+}
+
+void MatrixSolverIterative::solve_factorized(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec)
+{
+    /*
+
+    Solves for x in Ax = b reusing the preconditioner of A from the last call to solve.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+        Must be the same matrix (pattern and values) as in the last call to solve.
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+    x_vec : Eigen::VectorXd
+        x in Ax = b.
+        Contains the initial guess on input and the new solution on output.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    // iterate with the solver and preconditioner from the last call to solve
+    // settings changed since then take effect in the next call to solve
+    if (solver_id == -1)
+    {
+        solve(a_mat, b_vec, x_vec);
+        return;
+    }
+    solve_selected(a_mat, b_vec, x_vec, true);
+
+}
+
+int MatrixSolverIterative::get_num_iteration()
+{
+    /*
+
+    Returns the number of iterations done in the last solution.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    num_iteration : int
+        Number of iterations (-1 if the sparse LU fallback was used).
+
+    */
+
+    return num_iteration;
+
+}
+
+double MatrixSolverIterative::get_error()
+{
+    /*
+
+    Returns the relative residual of the last solution.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    error : double
+        Estimate of |Ax - b|/|b| after the last iteration.
+
+    */
+
+    return error;
+
+}
+
+void MatrixSolverIterative::set_fallback(bool is_fallback_enabled_in)
+{
+    /*
+
+    Sets whether systems that do not converge are solved with a sparse LU decomposition.
+
+    Arguments
+    =========
+    is_fallback_enabled_in : bool
+        true to solve with sparse LU if the iterations do not converge (default false).
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    is_fallback_enabled = is_fallback_enabled_in;
+
+}
+
+void MatrixSolverIterative::solve_selected(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec, bool is_factorized)
+{
+
+    // dispatch to the solver selected in the last call to solve
+    if (solver_id == 0)
+    {
+        solve_krylov(solver_cg_incomplete, a_mat, b_vec, x_vec, is_factorized);
+    }
+    else if (solver_id == 1)
+    {
+        solve_krylov(solver_cg_jacobi, a_mat, b_vec, x_vec, is_factorized);
+    }
+    else if (solver_id == 2)
+    {
+        solve_krylov(solver_bicgstab_incomplete, a_mat, b_vec, x_vec, is_factorized);
+    }
+    else
+    {
+        solve_krylov(solver_bicgstab_jacobi, a_mat, b_vec, x_vec, is_factorized);
+    }
+
+}
+
+template <typename SolverType>
+void MatrixSolverIterative::solve_krylov(SolverType &solver, Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec, bool is_factorized)
+{
+
+    // reuse sparse LU if it was needed for this matrix
+    if (is_factorized && is_fallback)
+    {
+        solver_fallback.solve_factorized(a_mat, b_vec, x_vec);
+        is_converged = solver_fallback.is_converged;
+        return;
+    }
+
+    // skip iterations if the method cannot be used with a_mat
+    // x_vec is left unchanged
+    if (!is_method_valid)
+    {
+        num_iteration = 0;
+        is_converged = false;
+    }
+    else
+    {
+
+        // compute preconditioner
+        // symbolic analysis is only redone if the sparsity pattern of a_mat changed since this solver last analyzed it
+        if (!is_factorized)
+        {
+            if (!is_analyzed_arr[solver_id])
+            {
+                solver.analyzePattern(a_mat);
+                is_analyzed_arr[solver_id] = true;
+            }
+            solver.factorize(a_mat);
+        }
+
+        // iterate starting from x_vec
+        // -1 restores the default of twice the number of equations
+        solver.setTolerance(tolerance);
+        solver.setMaxIterations(max_iteration > 0 ? max_iteration : -1);
+        Eigen::VectorXd x_guess_vec = x_vec;
+        x_vec = solver.solveWithGuess(b_vec, x_guess_vec);
+        num_iteration = solver.iterations();
+        error = solver.error();
+        is_converged = (solver.info() == Eigen::Success);
+
+    }
+
+    // use sparse LU if iterations did not converge and the fallback is enabled
+    is_fallback = (!is_converged && is_fallback_enabled);
+    if (is_fallback)
+    {
+        solver_fallback.solve(a_mat, b_vec, x_vec);
+        num_iteration = -1;
+        is_converged = solver_fallback.is_converged;
+    }
+
+}
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef MATRIXSOLVER_SPARSELU
+#define MATRIXSOLVER_SPARSELU
+#include "Eigen/Eigen"
+#include "matrixsolver_base.hpp"
+
+class MatrixSolverSparseLU : public MatrixSolverBase
+{
+    /*
+
+    Solves the matrix equation Ax = b using a sparse LU decomposition.
+
+    Functions
+    =========
+    solve : void
+        Solves for x in Ax = b.
+    solve_factorized : void
+        Solves for x in Ax = b reusing the factorization of A from the last call to solve.
+
+    Notes
+    =====
+    The column ordering and symbolic analysis are reused as long as the sparsity pattern of A is unchanged.
+    Only the numerical factorization is redone in each call.
+
+    If the factorization or solution fails (e.g., A is singular), x is left unchanged and get_is_converged returns false.
+    */
+
+    public:
+
+    // solver
+    Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> solver;
+
+    // functions
+    void solve(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec);
+    void solve_factorized(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec);
+
+    // default constructor
+    MatrixSolverSparseLU()
+    {
+
+    }
+
+};
+
+void MatrixSolverSparseLU::solve(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec)
+{
+    /*
+
+    Solves for x in Ax = b.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+    x_vec : Eigen::VectorXd
+        x in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    // symbolic analysis is only redone if the sparsity pattern of a_mat changes
+    // analyzePattern does not report errors; structural problems surface in factorize
+    a_mat.makeCompressed();
+    num_factorization++;
+    if (is_pattern_changed(a_mat))
+    {
+        solver.analyzePattern(a_mat);
+    }
+
+    // numerical factorization
+    // x_vec is left unchanged if a_mat is singular
+    solver.factorize(a_mat);
+    if (solver.info() != Eigen::Success)
+    {
+        is_converged = false;
+        return;
+    }
+
+    // solution
+    solve_factorized(a_mat, b_vec, x_vec);
+
+}
+
+void MatrixSolverSparseLU::solve_factorized(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec)
+{
+    /*
+
+    Solves for x in Ax = b reusing the factorization of A from the last call to solve.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+        Must be the same matrix (pattern and values) as in the last call to solve.
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+    x_vec : Eigen::VectorXd
+        x in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    // only the triangular solves are done
+    // skipped if the last factorization failed
+    static_cast<void>(a_mat);  // factorization of a_mat is kept in solver
+    if (solver.info() != Eigen::Success)
+    {
+        is_converged = false;
+        return;
+    }
+    Eigen::VectorXd x_solve_vec = solver.solve(b_vec);
+    is_converged = (solver.info() == Eigen::Success);
+    if (is_converged)
+    {
+        x_vec = x_solve_vec;
+    }
+
+}
+
+#endif
@@ -1,7 +1,12 @@
 #ifndef MESH_LINE2
 #define MESH_LINE2
+#include <iostream>
 #include <unordered_map>
+#include "container_binary.hpp"
 #include "container_typedef.hpp"
+#include "reader_binary.hpp"
+#include "reader_csv.hpp"
+#include "writer_binary.hpp"
 
 class MeshLine2
 {
@@ -15,6 +20,14 @@ class MeshLine2
         Path to CSV file with data for mesh points.
     file_in_element_str : string
         Path to CSV file with data for mesh elements.
+    file_in_binary_str : string
+        Path to binary file with data for mesh points and elements.
+        Used in place of the CSV files.
+
+    Functions
+    =========
+    output_binary : void
+        Outputs a binary file with the point and element data.
 
     Notes
     ====
@@ -26,18 +39,23 @@ class MeshLine2
         global point ID of local point 0
         global point ID of local point 1
     Point 0 and 1 refer to the left and right points of the each element.
+    The binary file is generated from the CSV files using output_binary.
+    It stores the same columns as contiguous arrays and is loaded without parsing.
+    Invalid or truncated binary files are reported on stderr and leave the mesh empty.
 
     */
 
     // did - domain ID
     // gid - global ID
     // vectors use did as input
+    // element_p0_did_vec and element_p1_did_vec are generated from the gid vectors in finalize_mesh
 
     public:
 
     // file names
     std::string file_in_point_str;
     std::string file_in_element_str;
+    std::string file_in_binary_str;
 
     // point data
     int num_point_domain = 0;
@@ -50,8 +68,13 @@ class MeshLine2
     VectorInt element_gid_vec;
     VectorInt element_p0_gid_vec;
     VectorInt element_p1_gid_vec;
+    VectorInt element_p0_did_vec;
+    VectorInt element_p1_did_vec;
     MapIntInt element_gid_to_did_map;
 
+    // functions
+    void output_binary(std::string file_out_str);
+
     // default constructor
     MeshLine2 ()
     {
@@ -70,6 +93,24 @@ class MeshLine2
         read_mesh_point(file_in_point_str);
         read_mesh_element(file_in_element_str);
 
+        // generate domain IDs of element points
+        finalize_mesh();
+
+    }
+
+    // constructor for binary files
+    MeshLine2 (std::string file_in_binary_str_in)
+    {
+
+        // store variables
+        file_in_binary_str = file_in_binary_str_in;
+
+        // read binary file
+        read_mesh_binary(file_in_binary_str);
+
+        // generate domain IDs of element points
+        finalize_mesh();
+
     }
     
     private:
@@ -77,6 +118,8 @@ class MeshLine2
     // functions
     void read_mesh_point(std::string file_in_point_str);
     void read_mesh_element(std::string file_in_element_str);
+    void read_mesh_binary(std::string file_in_binary_str);
+    void finalize_mesh();
 
 };
 
@@ -84,123 +127,173 @@ void MeshLine2::read_mesh_point(std::string file_in_point_str)
 {
 
     // read file with points
-    std::ifstream file_in_point_stream(file_in_point_str);
+    ReaderCSV reader_csv(file_in_point_str);
 
-    // initialize for iteration
-    bool is_point_header = true;  // true while reading header
-    std::string line_point_str;  // stores lines in files
+    // allocate vectors
+    num_point_domain = reader_csv.num_row;
+    point_gid_vec.resize(num_point_domain);
+    point_position_x_vec.resize(num_point_domain);
 
-    // iterate for each line in the file
-    while (std::getline(file_in_point_stream, line_point_str))
+    // store values in appropriate vector
+    for (int point_did = 0; point_did < num_point_domain; point_did++)
     {
+        point_gid_vec[point_did] = reader_csv.get_value_int(point_did, 0);
+        point_position_x_vec[point_did] = reader_csv.get_value(point_did, 1);
+    }
 
-        // skip header
-        if (is_point_header)
-        {
-            is_point_header = false; // not reading header
-            continue;
-        }
-
-        // count number of particles
-        num_point_domain++;
+}
 
-        // convert line string into stringstream
-        std::stringstream line_point_stream(line_point_str);
+void MeshLine2::read_mesh_element(std::string file_in_element_str)
+{
 
-        // initialize for iteration
-        int value_point_num = 0;  // counts position of value
-        std::string value_point_str;  // stores values in lines
+    // read file with elements
+    ReaderCSV reader_csv(file_in_element_str);
 
-        // iterate through each value
-        while (std::getline(line_point_stream, value_point_str, ','))
-        {
+    // allocate vectors
+    num_element_domain = reader_csv.num_row;
+    element_gid_vec.resize(num_element_domain);
+    element_p0_gid_vec.resize(num_element_domain);
+    element_p1_gid_vec.resize(num_element_domain);
 
-            // store values in appropriate vector
-            switch (value_point_num)
-            {
-                case 0: point_gid_vec.push_back(std::stoi(value_point_str)); break;
-                case 1: point_position_x_vec.push_back(std::stod(value_point_str)); break;
-            }
+    // store values in appropriate vector
+    for (int element_did = 0; element_did < num_element_domain; element_did++)
+    {
+        element_gid_vec[element_did] = reader_csv.get_value_int(element_did, 0);
+        element_p0_gid_vec[element_did] = reader_csv.get_value_int(element_did, 1);
+        element_p1_gid_vec[element_did] = reader_csv.get_value_int(element_did, 2);
+    }
 
-            // increment value count
-            value_point_num++;
+}
 
-        }
+void MeshLine2::read_mesh_binary(std::string file_in_binary_str)
+{
 
+    // map binary file
+    // arrays: point gid, point x, element gid, element p0 gid, element p1 gid
+    ReaderBinary reader_binary(file_in_binary_str);
+    if (!reader_binary.is_valid || reader_binary.file_type != binary_file_mesh || reader_binary.num_array < 5)
+    {
+        std::cerr << "MeshLine2: " << file_in_binary_str << " is not a valid mesh file.\n";
+        return;
     }
 
-    // close point file
-    file_in_point_stream.close();
-
-    // generate map of global to domain ID for points
-    for (int point_did = 0; point_did < num_point_domain; point_did++)
+    // get pointers to arrays in file
+    const int *point_gid_ptr = reader_binary.get_array_int_ptr(0);
+    const double *point_position_x_ptr = reader_binary.get_array_double_ptr(1);
+    const int *element_gid_ptr = reader_binary.get_array_int_ptr(2);
+    const int *element_p0_gid_ptr = reader_binary.get_array_int_ptr(3);
+    const int *element_p1_gid_ptr = reader_binary.get_array_int_ptr(4);
+
+    // check types and lengths of arrays
+    // arrays of the same entity must have the same number of values
+    int num_point_file = reader_binary.get_num_value(0);
+    int num_element_file = reader_binary.get_num_value(2);
+    bool is_array_valid = (
+        point_gid_ptr && point_position_x_ptr && element_gid_ptr && element_p0_gid_ptr && element_p1_gid_ptr &&
+        reader_binary.get_num_value(1) == num_point_file &&
+        reader_binary.get_num_value(3) == num_element_file &&
+        reader_binary.get_num_value(4) == num_element_file
+    );
+    if (!is_array_valid)
     {
-        int point_gid = point_gid_vec[point_did];
-        point_gid_to_did_map[point_gid] = point_did;
+        std::cerr << "MeshLine2: " << file_in_binary_str << " has arrays with unexpected types or lengths.\n";
+        return;
     }
 
+    // store point data
+    num_point_domain = num_point_file;
+    point_gid_vec.assign(point_gid_ptr, point_gid_ptr + num_point_domain);
+    point_position_x_vec.assign(point_position_x_ptr, point_position_x_ptr + num_point_domain);
+
+    // store element data
+    num_element_domain = num_element_file;
+    element_gid_vec.assign(element_gid_ptr, element_gid_ptr + num_element_domain);
+    element_p0_gid_vec.assign(element_p0_gid_ptr, element_p0_gid_ptr + num_element_domain);
+    element_p1_gid_vec.assign(element_p1_gid_ptr, element_p1_gid_ptr + num_element_domain);
+
 }
 
-void MeshLine2::read_mesh_element(std::string file_in_element_str)
+void MeshLine2::output_binary(std::string file_out_str)
 {
+    /*
 
-    // read file with elements
-    std::ifstream file_in_element_stream(file_in_element_str);  
+    Outputs a binary file with the point and element data.
 
-    // initialize for iteration
-    bool is_element_header = true;  // true while reading header
-    std::string line_element_str;  // stores lines in files
+    Arguments
+    =========
+    file_out_str : string
+        Path to binary file.
 
-    // iterate for each line in the file
-    while (std::getline(file_in_element_stream, line_element_str))
-    {
+    Returns
+    =======
+    (none)
 
-        // skip header
-        if (is_element_header)
-        {
-            is_element_header = false; // not reading header
-            continue;
-        }
+    Notes
+    =====
+    The file can be loaded using the MeshLine2 constructor for binary files.
+    This is used to convert the CSV files of a mesh into a single binary file.
 
-        // count number of particles
-        num_element_domain++;
+    */
 
-        // convert line string into stringstream
-        std::stringstream line_element_stream(line_element_str);
+    // write arrays in the order expected by read_mesh_binary
+    WriterBinary writer_binary(binary_file_mesh);
+    writer_binary.add_array(point_gid_vec);
+    writer_binary.add_array(point_position_x_vec);
+    writer_binary.add_array(element_gid_vec);
+    writer_binary.add_array(element_p0_gid_vec);
+    writer_binary.add_array(element_p1_gid_vec);
+    writer_binary.write_file(file_out_str);
 
-        // initialize for iteration
-        int value_element_num = 0;  // counts position of value
-        std::string value_element_str;  // stores values in lines
+}
 
-        // iterate through each value
-        while (std::getline(line_element_stream, value_element_str, ','))
-        {
+void MeshLine2::finalize_mesh()
+{
+    /*
 
-            // store values in appropriate vector
-            switch (value_element_num)
-            {
-                case 0: element_gid_vec.push_back(std::stoi(value_element_str)); break;
-                case 1: element_p0_gid_vec.push_back(std::stod(value_element_str)); break;
-                case 2: element_p1_gid_vec.push_back(std::stod(value_element_str)); break;
-            }
+    Generates maps of global to domain IDs and the domain IDs of the points around each element.
 
-            // increment value count
-            value_element_num++;
+    Arguments
+    =========
+    (none)
 
-        }
+    Returns
+    =======
+    (none)
 
-    }
+    Notes
+    =====
+    Must be called after the point and element data are read.
+    The domain IDs are used in element loops in place of point_gid_to_did_map.
+
+    */
 
-    // close element file
-    file_in_element_stream.close();
+    // generate map of global to domain ID for points
+    point_gid_to_did_map.reserve(num_point_domain);
+    for (int point_did = 0; point_did < num_point_domain; point_did++)
+    {
+        int point_gid = point_gid_vec[point_did];
+        point_gid_to_did_map[point_gid] = point_did;
+    }
 
     // generate map of global to domain ID for elements
+    element_gid_to_did_map.reserve(num_element_domain);
     for (int element_did = 0; element_did < num_element_domain; element_did++)
     {
         int element_gid = element_gid_vec[element_did];
         element_gid_to_did_map[element_gid] = element_did;
     }
 
+    // initialize domain ID vectors
+    element_p0_did_vec = VectorInt(num_element_domain);
+    element_p1_did_vec = VectorInt(num_element_domain);
+
+    // convert global IDs of element points into domain IDs
+    for (int element_did = 0; element_did < num_element_domain; element_did++)
+    {
+        element_p0_did_vec[element_did] = point_gid_to_did_map.at(element_p0_gid_vec[element_did]);
+        element_p1_did_vec[element_did] = point_gid_to_did_map.at(element_p1_gid_vec[element_did]);
+    }
+
 }
 
 #endif
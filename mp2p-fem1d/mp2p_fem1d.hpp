@@ -13,12 +13,21 @@
 
 #include "boundary_line2.hpp"
 #include "boundary_field.hpp"
+#include "container_binary.hpp"
 #include "container_boundaryconfig.hpp"
+#include "container_series.hpp"
+#include "container_triplet.hpp"
 #include "container_typedef.hpp"
+#include "controller_timestep.hpp"
 #include "integral_line2.hpp"
 #include "integral_field.hpp"
 #include "matrixequation_steady.hpp"
 #include "matrixequation_transient.hpp"
+#include "matrixsolver_banded.hpp"
+#include "matrixsolver_base.hpp"
+#include "matrixsolver_iterative.hpp"
+#include "matrixsolver_ldlt.hpp"
+#include "matrixsolver_sparselu.hpp"
 #include "mesh_line2.hpp"
 #include "mesh_field.hpp"
 #include "physicssteady_base.hpp"
@@ -27,7 +36,14 @@
 #include "physicstransient_base.hpp"
 #include "physicstransient_convectiondiffusion.hpp"
 #include "physicstransient_diffusion.hpp"
+#include "reader_binary.hpp"
+#include "reader_csv.hpp"
+#include "reader_series.hpp"
+#include "recorder_series.hpp"
 #include "scalar_field.hpp"
 #include "scalar_line2.hpp"
 #include "variable_field.hpp"
 #include "variable_line2.hpp"
+#include "writer_binary.hpp"
+#include "writer_csv.hpp"
+#include "writer_series.hpp"
@@ -1,8 +1,11 @@
 #ifndef PHYSICSSTEADY_BASE
 #define PHYSICSSTEADY_BASE
+#include <algorithm>
+#include <set>
 #include <vector>
 #include "Eigen/Eigen"
 #include "boundary_field.hpp"
+#include "container_triplet.hpp"
 #include "container_typedef.hpp"
 #include "mesh_field.hpp"
 #include "scalar_field.hpp"
@@ -19,12 +22,29 @@ class PhysicsSteadyBase
     =========
     matrix_fill : void
         Fill up the matrix equation Ax = b with entries as dictated by the physics. 
+    matrix_fill_jacobian : void
+        Adds the Jacobian contributions of the physics to the matrix equation for Newton iterations.
+    matrix_fill_elimination : void
+        Eliminates known values from the columns of A after all physics have filled up A and b.
+    matrix_pattern : void
+        Adds the entries of A that are filled up by the physics to a vector of triplets.
+    set_matrix_slot : void
+        Stores the positions of the entries filled up by the physics in the compressed storage of A.
     set_start_row : void
         Sets the starting row in A and b where entries are filled up.
     get_start_row : int
         Returns the starting row.
     get_variable_field_ptr_vec() : vector<VariableField*>
         Returns the vector containing pointers to VariableField objects tied to this physics.
+    get_value_row_vec() : VectorInt
+        Returns the rows of A where value BCs are applied.
+    check_derivative_variable : bool
+        Removes Jacobian derivatives with respect to variables that are not solved for in the matrix equation.
+
+    Notes
+    =====
+    Physics with a generation term c(x) tested against Ni share the Jacobian of this term.
+    The derivatives dc/dv are stored here, and the protected functions generation_jacobian_pattern, set_generation_jacobian_slot, and generation_jacobian_fill handle their entries in A.
 
     */
 
@@ -41,11 +61,22 @@ class PhysicsSteadyBase
     // starting row of test functions in matrix equation
     int start_row = -1;
 
+    // derivatives of the generation coefficient c with respect to variables
+    // dc/dv of each variable v is supplied as a scalar at each point
+    std::vector<VariableField*> derivative_variable_field_ptr_vec;
+    std::vector<ScalarField*> derivative_field_ptr_vec;
+
     // functions
     virtual void matrix_fill(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec);
+    virtual void matrix_fill_jacobian(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec);
+    virtual void matrix_fill_elimination(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec);
+    virtual void matrix_pattern(VectorTriplet &a_triplet_vec);
+    virtual void set_matrix_slot(Eigen::SparseMatrix<double> &a_mat);
     virtual void set_start_row(int start_row_in);
     virtual int get_start_row();
     virtual std::vector<VariableField*> get_variable_field_ptr_vec();
+    virtual VectorInt get_value_row_vec();
+    virtual bool check_derivative_variable(std::set<VariableField*> &variable_field_ptr_set);
 
     // default constructor
     PhysicsSteadyBase()
@@ -53,6 +84,29 @@ class PhysicsSteadyBase
 
     }
 
+    protected:
+
+    // positions of Jacobian entries of the generation term in the compressed storage of A
+    // outer vector: derivative index; middle vector: domain index; inner vector: entry of point i of element at 2*element_did + i
+    std::vector<std::vector<VectorInt>> element_jacobian_mat_slot_vec;  // -1 if skipped
+    std::vector<std::vector<VectorInt>> element_jacobian_mat_row_vec;  // row of the test function at the point
+    std::vector<std::vector<VectorInt>> element_jacobian_mat_col_vec;  // column of the variable at the point
+
+    // functions
+    int get_matrix_slot(Eigen::SparseMatrix<double> &a_mat, int mat_row, int mat_col);
+    void generation_jacobian_pattern(VectorTriplet &a_triplet_vec, MeshField *mesh_field_in_ptr, VariableField *value_field_in_ptr, int start_row_in);
+    void set_generation_jacobian_slot
+    (
+        Eigen::SparseMatrix<double> &a_mat, MeshField *mesh_field_in_ptr, VariableField *value_field_in_ptr, int start_row_in,
+        std::vector<bool> &is_value_row_vec
+    );
+    void generation_jacobian_fill
+    (
+        Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec,
+        MeshField *mesh_field_in_ptr, IntegralField *integral_field_in_ptr
+    );
+    int get_derivative_col(VariableField *derivative_variable_field_ptr, int point_gid);
+
 };
 
 void PhysicsSteadyBase::matrix_fill(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec)
@@ -78,6 +132,103 @@ void PhysicsSteadyBase::matrix_fill(Eigen::SparseMatrix<double> &a_mat, Eigen::V
 
 }
 
+void PhysicsSteadyBase::matrix_fill_jacobian(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec)
+{
+    /*
+
+    Adds the Jacobian contributions of the physics to the matrix equation for Newton iterations.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+    x_vec : Eigen::VectorXd
+        x in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Called after matrix_fill.
+    If b depends on x through b(x), a Newton step solves (A - D) x_new = b - D x, where D = d(b)/dx.
+    Physics add -D to A and -D x to b here; physics without such terms add nothing.
+
+    */
+
+}
+
+void PhysicsSteadyBase::matrix_fill_elimination(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec)
+{
+    /*
+
+    Eliminates known values from the columns of A after all physics have filled up A and b.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Called after matrix_fill and matrix_fill_jacobian of every physics in the matrix equation.
+    Entries A_ij in the column of a known x_j are moved to b as -A_ij * x_j, so entries added by any physics are included.
+    Physics that do not apply value BCs symmetrically do nothing here.
+
+    */
+
+    static_cast<void>(a_mat);
+    static_cast<void>(b_vec);
+
+}
+
+void PhysicsSteadyBase::matrix_pattern(VectorTriplet &a_triplet_vec)
+{
+    /*
+
+    Adds the entries of A that are filled up by the physics to a vector of triplets.
+
+    Arguments
+    =========
+    a_triplet_vec : VectorTriplet
+        vector of (row, column, value) triplets of A.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+}
+
+void PhysicsSteadyBase::set_matrix_slot(Eigen::SparseMatrix<double> &a_mat)
+{
+    /*
+
+    Stores the positions of the entries filled up by the physics in the compressed storage of A.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+}
+
 void PhysicsSteadyBase::set_start_row(int start_row_in)
 {
     /*
@@ -141,4 +292,384 @@ std::vector<VariableField*> PhysicsSteadyBase::get_variable_field_ptr_vec()
 
 }
 
+VectorInt PhysicsSteadyBase::get_value_row_vec()
+{
+    /*
+
+    Returns the rows of A where value BCs are applied.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    value_row_vec : VectorInt
+        Rows of A where value BCs are applied.
+
+    Notes
+    =====
+    Each of these rows is replaced by the equation a_ii * x_i = b_i in matrix_fill.
+
+    */
+
+    return {};
+
+}
+
+bool PhysicsSteadyBase::check_derivative_variable(std::set<VariableField*> &variable_field_ptr_set)
+{
+    /*
+
+    Removes Jacobian derivatives with respect to variables that are not solved for in the matrix equation.
+
+    Arguments
+    =========
+    variable_field_ptr_set : set<VariableField*>
+        Variable fields solved for in the matrix equation.
+
+    Returns
+    =======
+    is_valid : bool
+        true if all derivatives are with respect to variables in the matrix equation.
+
+    Notes
+    =====
+    Called by MatrixEquationSteady before the sparsity pattern of A is generated.
+    Columns of other variables are unassigned (start_col = -1) or belong to another matrix equation.
+    Their entries would lie outside of A or couple to unrelated unknowns in x.
+    MatrixEquationSteady is marked invalid if false is returned (see MatrixEquationSteady::is_valid).
+
+    */
+
+    // keep derivatives with respect to variables in the matrix equation
+    int num_derivative = derivative_variable_field_ptr_vec.size();
+    int num_derivative_keep = 0;
+    for (int indx_k = 0; indx_k < num_derivative; indx_k++)
+    {
+        if (variable_field_ptr_set.count(derivative_variable_field_ptr_vec[indx_k]) == 0)
+        {
+            continue;
+        }
+        derivative_variable_field_ptr_vec[num_derivative_keep] = derivative_variable_field_ptr_vec[indx_k];
+        derivative_field_ptr_vec[num_derivative_keep] = derivative_field_ptr_vec[indx_k];
+        num_derivative_keep++;
+    }
+    derivative_variable_field_ptr_vec.resize(num_derivative_keep);
+    derivative_field_ptr_vec.resize(num_derivative_keep);
+
+    return num_derivative_keep == num_derivative;
+
+}
+
+int PhysicsSteadyBase::get_matrix_slot(Eigen::SparseMatrix<double> &a_mat, int mat_row, int mat_col)
+{
+    /*
+
+    Returns the position of an entry in the compressed storage of A.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+    mat_row : int
+        Row of the entry.
+    mat_col : int
+        Column of the entry.
+
+    Returns
+    =======
+    mat_slot : int
+        Index of the entry in a_mat.valuePtr().
+        -1 if the entry is not in the sparsity pattern of A.
+
+    */
+
+    // search rows in column (sorted in compressed storage)
+    const int *inner_start_ptr = a_mat.innerIndexPtr() + a_mat.outerIndexPtr()[mat_col];
+    const int *inner_end_ptr = a_mat.innerIndexPtr() + a_mat.outerIndexPtr()[mat_col + 1];
+    const int *inner_ptr = std::lower_bound(inner_start_ptr, inner_end_ptr, mat_row);
+
+    // return position if entry is found
+    if (inner_ptr == inner_end_ptr || *inner_ptr != mat_row)
+    {
+        return -1;
+    }
+    return inner_ptr - a_mat.innerIndexPtr();
+
+}
+
+int PhysicsSteadyBase::get_derivative_col(VariableField *derivative_variable_field_ptr, int point_gid)
+{
+    /*
+
+    Returns the column of a variable at a point.
+
+    Arguments
+    =========
+    derivative_variable_field_ptr : VariableField*
+        Variable that the generation coefficient depends on.
+    point_gid : int
+        Global ID of the point.
+
+    Returns
+    =======
+    mat_col : int
+        Column in A of the variable at the point.
+        -1 if the variable is not defined at the point.
+
+    Notes
+    =====
+    The variable may cover fewer domains than the physics.
+    point_gid_to_fid_map is searched instead of indexed so that no entries are added to it.
+
+    */
+
+    auto point_fid_iter = derivative_variable_field_ptr->point_gid_to_fid_map.find(point_gid);
+    if (point_fid_iter == derivative_variable_field_ptr->point_gid_to_fid_map.end())
+    {
+        return -1;
+    }
+    return derivative_variable_field_ptr->start_col + point_fid_iter->second;
+
+}
+
+void PhysicsSteadyBase::generation_jacobian_pattern(VectorTriplet &a_triplet_vec, MeshField *mesh_field_in_ptr, VariableField *value_field_in_ptr, int start_row_in)
+{
+    /*
+
+    Adds the Jacobian entries of the generation term to a vector of triplets.
+
+    Arguments
+    =========
+    a_triplet_vec : VectorTriplet
+        vector of (row, column, value) triplets of A.
+    mesh_field_in_ptr : MeshField*
+        Meshes where the physics is applied to.
+    value_field_in_ptr : VariableField*
+        Variable solved for by the physics.
+    start_row_in : int
+        Starting row of the physics in A.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Each derivative couples a point to the variable at the same point.
+    Domains without a derivative scalar and points where the variable is not defined are skipped.
+
+    */
+
+    // iterate through each derivative and each domain covered by the mesh
+    int num_derivative = derivative_variable_field_ptr_vec.size();
+    for (int indx_k = 0; indx_k < num_derivative; indx_k++){
+    for (auto mesh_ptr : mesh_field_in_ptr->mesh_l2_ptr_vec){
+
+        // skip domains without derivative
+        VariableField *derivative_variable_field_ptr = derivative_variable_field_ptr_vec[indx_k];
+        if (derivative_field_ptr_vec[indx_k]->scalar_ptr_map.count(mesh_ptr) == 0)
+        {
+            continue;
+        }
+
+        // iterate for each domain element
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
+        {
+            int point_gid_arr[2] = {mesh_ptr->element_p0_gid_vec[element_did], mesh_ptr->element_p1_gid_vec[element_did]};
+            for (int indx_i = 0; indx_i < 2; indx_i++)
+            {
+                int mat_col = get_derivative_col(derivative_variable_field_ptr, point_gid_arr[indx_i]);
+                if (mat_col == -1)
+                {
+                    continue;
+                }
+                int mat_row = start_row_in + value_field_in_ptr->point_gid_to_fid_map[point_gid_arr[indx_i]];
+                a_triplet_vec.emplace_back(mat_row, mat_col, 0.);
+            }
+        }
+
+    }}
+
+}
+
+void PhysicsSteadyBase::set_generation_jacobian_slot
+(
+    Eigen::SparseMatrix<double> &a_mat, MeshField *mesh_field_in_ptr, VariableField *value_field_in_ptr, int start_row_in,
+    std::vector<bool> &is_value_row_vec
+)
+{
+    /*
+
+    Stores the positions of the Jacobian entries of the generation term in the compressed storage of A.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+    mesh_field_in_ptr : MeshField*
+        Meshes where the physics is applied to.
+    value_field_in_ptr : VariableField*
+        Variable solved for by the physics.
+    start_row_in : int
+        Starting row of the physics in A.
+    is_value_row_vec : vector<bool>
+        true for rows of A where the physics applies value BCs.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    A must contain the entries added in generation_jacobian_pattern.
+    Entries in rows with value BCs, in domains without a derivative scalar, and at points where the variable is not defined are skipped (-1).
+
+    */
+
+    // clear positions
+    element_jacobian_mat_slot_vec.assign(derivative_variable_field_ptr_vec.size(), std::vector<VectorInt>());
+    element_jacobian_mat_row_vec.assign(derivative_variable_field_ptr_vec.size(), std::vector<VectorInt>());
+    element_jacobian_mat_col_vec.assign(derivative_variable_field_ptr_vec.size(), std::vector<VectorInt>());
+
+    // iterate through each derivative and each domain covered by the mesh
+    int num_derivative = derivative_variable_field_ptr_vec.size();
+    for (int indx_k = 0; indx_k < num_derivative; indx_k++){
+    for (auto mesh_ptr : mesh_field_in_ptr->mesh_l2_ptr_vec){
+
+        // initialize positions in this domain
+        // all entries are skipped in domains without derivative
+        VariableField *derivative_variable_field_ptr = derivative_variable_field_ptr_vec[indx_k];
+        bool is_derivative = derivative_field_ptr_vec[indx_k]->scalar_ptr_map.count(mesh_ptr) > 0;
+        VectorInt element_jacobian_mat_slot_part_vec(2*mesh_ptr->num_element_domain, -1);
+        VectorInt element_jacobian_mat_row_part_vec(2*mesh_ptr->num_element_domain, -1);
+        VectorInt element_jacobian_mat_col_part_vec(2*mesh_ptr->num_element_domain, -1);
+
+        // iterate for each domain element
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain && is_derivative; element_did++)
+        {
+            int point_gid_arr[2] = {mesh_ptr->element_p0_gid_vec[element_did], mesh_ptr->element_p1_gid_vec[element_did]};
+            for (int indx_i = 0; indx_i < 2; indx_i++)
+            {
+                int mat_col = get_derivative_col(derivative_variable_field_ptr, point_gid_arr[indx_i]);
+                int mat_row = start_row_in + value_field_in_ptr->point_gid_to_fid_map[point_gid_arr[indx_i]];
+                if (mat_col == -1 || is_value_row_vec[mat_row])
+                {
+                    continue;
+                }
+                element_jacobian_mat_slot_part_vec[2*element_did + indx_i] = get_matrix_slot(a_mat, mat_row, mat_col);
+                element_jacobian_mat_row_part_vec[2*element_did + indx_i] = mat_row;
+                element_jacobian_mat_col_part_vec[2*element_did + indx_i] = mat_col;
+            }
+        }
+
+        // store positions in this domain
+        element_jacobian_mat_slot_vec[indx_k].push_back(element_jacobian_mat_slot_part_vec);
+        element_jacobian_mat_row_vec[indx_k].push_back(element_jacobian_mat_row_part_vec);
+        element_jacobian_mat_col_vec[indx_k].push_back(element_jacobian_mat_col_part_vec);
+
+    }}
+
+}
+
+void PhysicsSteadyBase::generation_jacobian_fill
+(
+    Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec,
+    MeshField *mesh_field_in_ptr, IntegralField *integral_field_in_ptr
+)
+{
+    /*
+
+    Adds the Jacobian contributions of the generation term to the matrix equation.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+    x_vec : Eigen::VectorXd
+        x in Ax = b.
+    mesh_field_in_ptr : MeshField*
+        Meshes where the physics is applied to.
+    integral_field_in_ptr : IntegralField*
+        Test function integrals of the meshes.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    The generation term adds c(x) * integral_Ni to b, so the Jacobian of Ax - b is A - D, where D = d(b)/dx.
+    A Newton step solves (A - D) x_new = b - D x, so -D is added to A and -D x is added to b.
+    The positions of entries are precomputed in set_generation_jacobian_slot.
+
+    */
+
+    // iterate through each derivative and each domain covered by the mesh
+    int num_derivative = derivative_variable_field_ptr_vec.size();
+    int num_domain = mesh_field_in_ptr->mesh_l2_ptr_vec.size();
+    for (int indx_k = 0; indx_k < num_derivative; indx_k++){
+    for (int indx_d = 0; indx_d < num_domain; indx_d++){
+
+        // subset the mesh and integrals
+        MeshLine2 *mesh_ptr = mesh_field_in_ptr->mesh_l2_ptr_vec[indx_d];
+        IntegralLine2 *integral_ptr = integral_field_in_ptr->integral_l2_ptr_vec[indx_d];
+
+        // get derivative
+        // skip domains without derivative
+        auto derivative_iter = derivative_field_ptr_vec[indx_k]->scalar_ptr_map.find(mesh_ptr);
+        if (derivative_iter == derivative_field_ptr_vec[indx_k]->scalar_ptr_map.end())
+        {
+            continue;
+        }
+        ScalarLine2 *derivative_ptr = derivative_iter->second;
+
+        // get storage of matrix equation and precomputed positions of entries
+        double *a_value_ptr = a_mat.valuePtr();
+        double *b_value_ptr = b_vec.data();
+        const double *x_value_ptr = x_vec.data();
+        const int *element_jacobian_mat_slot_ptr = element_jacobian_mat_slot_vec[indx_k][indx_d].data();
+        const int *element_jacobian_mat_row_ptr = element_jacobian_mat_row_vec[indx_k][indx_d].data();
+        const int *element_jacobian_mat_col_ptr = element_jacobian_mat_col_vec[indx_k][indx_d].data();
+
+        // iterate for each domain element
+        #ifdef _OPENMP
+        #pragma omp parallel for
+        #endif
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
+        {
+
+            // get domain ID of points around element
+            int did_arr[2] = {mesh_ptr->element_p0_did_vec[element_did], mesh_ptr->element_p1_did_vec[element_did]};
+
+            // add -D to a_mat and -D x to b_vec
+            for (int indx_i = 0; indx_i < 2; indx_i++)
+            {
+                int mat_slot = element_jacobian_mat_slot_ptr[2*element_did + indx_i];
+                if (mat_slot == -1)
+                {
+                    continue;
+                }
+                int mat_row = element_jacobian_mat_row_ptr[2*element_did + indx_i];
+                int mat_col = element_jacobian_mat_col_ptr[2*element_did + indx_i];
+                double d_value = derivative_ptr->point_value_vec[did_arr[indx_i]]*integral_ptr->integral_Ni_vec[element_did][indx_i];
+                #ifdef _OPENMP
+                #pragma omp atomic
+                #endif
+                a_value_ptr[mat_slot] -= d_value;
+                #ifdef _OPENMP
+                #pragma omp atomic
+                #endif
+                b_value_ptr[mat_row] -= d_value*x_value_ptr[mat_col];
+            }
+
+        }
+
+    }}
+
+}
+
 #endif
@@ -3,6 +3,7 @@
 #include <vector>
 #include "Eigen/Eigen"
 #include "boundary_field.hpp"
+#include "container_triplet.hpp"
 #include "container_typedef.hpp"
 #include "integral_field.hpp"
 #include "mesh_field.hpp"
@@ -38,12 +39,26 @@ class PhysicsSteadyDiffusion : public PhysicsSteadyBase
     =========
     matrix_fill : void
         Fill up the matrix equation Ax = b with entries as dictated by the physics. 
+    matrix_fill_jacobian : void
+        Adds the derivatives of the generation coefficient to the matrix equation for Newton iterations.
+    matrix_fill_elimination : void
+        Eliminates value BCs from the columns of A after all physics have filled up A and b.
+    set_generation_derivative : void
+        Sets the derivative of the generation coefficient with respect to a variable.
+    set_dirichlet_symmetric : void
+        Sets whether value BCs are also eliminated from the columns of A to keep A symmetric.
+    matrix_pattern : void
+        Adds the entries of A that are filled up by the physics to a vector of triplets.
+    set_matrix_slot : void
+        Stores the positions of the entries filled up by the physics in the compressed storage of A.
     set_start_row : void
         Sets the starting row in A and b where entries are filled up.
     get_start_row : int
         Returns the starting row.
     get_variable_field_ptr_vec() : vector<VariableField*>
         Returns the vector containing pointers to VariableField objects tied to this physics.
+    get_value_row_vec() : VectorInt
+        Returns the rows of A where value BCs are applied.
 
     */
 
@@ -63,11 +78,34 @@ class PhysicsSteadyDiffusion : public PhysicsSteadyBase
     // starting row of test functions in matrix equation
     int start_row = -1;
 
+    // positions of entries in the compressed storage of A
+    // outer vector: domain index; inner vector: position of each entry
+    std::vector<VectorInt> element_mat_slot_vec;  // entry (i, j) of element at 4*element_did + 2*i + j
+    std::vector<VectorInt> element_mat_row_vec;  // row of point i of element at 2*element_did + i
+    std::vector<VectorInt> element_flux_mat_slot_vec;  // diagonal entry of each flux BC
+    std::vector<VectorInt> element_flux_mat_row_vec;  // row of each flux BC
+    std::vector<VectorInt> element_value_mat_slot_vec;  // diagonal entry of each value BC
+    std::vector<VectorInt> element_value_mat_row_vec;  // row of each value BC
+    std::vector<VectorInt> element_value_row_mat_slot_vec;  // all entries in rows of value BCs
+    std::vector<VectorInt> element_value_col_mat_slot_vec;  // entries in columns of value BCs outside rows of value BCs
+    std::vector<VectorInt> element_value_col_mat_row_vec;  // row of each entry in columns of value BCs
+    std::vector<VectorInt> element_value_col_boundary_id_vec;  // value BC of each entry in columns of value BCs
+
+    // symmetric treatment of value BCs
+    bool is_dirichlet_symmetric = false;
+
     // functions
     void matrix_fill(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec);
+    void matrix_fill_jacobian(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec);
+    void matrix_fill_elimination(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec);
+    void set_generation_derivative(VariableField &variable_field_in, ScalarField &derivative_field_in);
+    void set_dirichlet_symmetric(bool is_dirichlet_symmetric_in);
+    void matrix_pattern(VectorTriplet &a_triplet_vec);
+    void set_matrix_slot(Eigen::SparseMatrix<double> &a_mat);
     void set_start_row(int start_row_in);
     int get_start_row();
     std::vector<VariableField*> get_variable_field_ptr_vec();
+    VectorInt get_value_row_vec();
 
     // default constructor
     PhysicsSteadyDiffusion()
@@ -105,7 +143,7 @@ class PhysicsSteadyDiffusion : public PhysicsSteadyBase
     void matrix_fill_domain
     (
         Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec,
-        MeshLine2 *mesh_ptr, BoundaryLine2 *boundary_ptr, IntegralLine2 *integral_ptr,
+        int indx_d, MeshLine2 *mesh_ptr, BoundaryLine2 *boundary_ptr, IntegralLine2 *integral_ptr,
         ScalarLine2 *diffusioncoefficient_ptr, ScalarLine2 *generationcoefficient_ptr
     );
 
@@ -149,7 +187,75 @@ void PhysicsSteadyDiffusion::matrix_fill
         ScalarLine2 *generationcoefficient_ptr = generationcoefficient_field_ptr->scalar_ptr_map[mesh_ptr];
 
         // determine matrix coefficients for the domain
-        matrix_fill_domain(a_mat, b_vec, x_vec, mesh_ptr, boundary_ptr, integral_ptr, diffusioncoefficient_ptr, generationcoefficient_ptr);
+        matrix_fill_domain(a_mat, b_vec, x_vec, indx_d, mesh_ptr, boundary_ptr, integral_ptr, diffusioncoefficient_ptr, generationcoefficient_ptr);
+
+    }
+
+}
+
+void PhysicsSteadyDiffusion::matrix_fill_elimination(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec)
+{
+    /*
+
+    Eliminates value BCs from the columns of A after all physics have filled up A and b.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Only done if set_dirichlet_symmetric(true) was called.
+    Entries in the columns of value BC points outside rows with value BCs are moved to b as -A_ij * value.
+    This is called by MatrixEquationSteady after all physics and Jacobians are filled up, so entries added by any of them are moved.
+
+    */
+
+    // skip unless value BCs are applied symmetrically
+    if (!is_dirichlet_symmetric)
+    {
+        return;
+    }
+
+    // get storage of matrix equation
+    double *a_value_ptr = a_mat.valuePtr();
+    double *b_value_ptr = b_vec.data();
+
+    // iterate through each domain covered by the mesh
+    int num_domain = mesh_field_ptr->mesh_l2_ptr_vec.size();
+    for (int indx_d = 0; indx_d < num_domain; indx_d++)
+    {
+
+        // subset the boundary
+        BoundaryLine2 *boundary_ptr = boundary_field_ptr->boundary_l2_ptr_vec[indx_d];
+
+        // iterate through entries in columns with value BCs
+        int num_value_col_entry = element_value_col_mat_slot_vec[indx_d].size();
+        for (int indx_k = 0; indx_k < num_value_col_entry; indx_k++)
+        {
+
+            // identify boundary type
+            int boundary_id = element_value_col_boundary_id_vec[indx_d][indx_k];
+            int boundary_type = boundary_ptr->element_value_type_vec[boundary_id];
+            const double *parameter_ptr = &boundary_ptr->element_value_parameter_vec[boundary_id];
+
+            // move entry to b_vec
+            if (boundary_type == boundary_type_dirichlet)
+            {
+                int mat_slot = element_value_col_mat_slot_vec[indx_d][indx_k];
+                int mat_row = element_value_col_mat_row_vec[indx_d][indx_k];
+                b_value_ptr[mat_row] -= a_value_ptr[mat_slot]*parameter_ptr[0];
+                a_value_ptr[mat_slot] = 0.;
+            }
+
+        }
 
     }
 
@@ -158,23 +264,32 @@ void PhysicsSteadyDiffusion::matrix_fill
 void PhysicsSteadyDiffusion::matrix_fill_domain
 (
     Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec,
-    MeshLine2 *mesh_ptr, BoundaryLine2 *boundary_ptr, IntegralLine2 *integral_ptr,
+    int indx_d, MeshLine2 *mesh_ptr, BoundaryLine2 *boundary_ptr, IntegralLine2 *integral_ptr,
     ScalarLine2 *diffusioncoefficient_ptr, ScalarLine2 *generationcoefficient_ptr
 )
 {
 
+    // get storage of matrix equation
+    // entries are added directly to the compressed storage of a_mat
+    double *a_value_ptr = a_mat.valuePtr();
+    double *b_value_ptr = b_vec.data();
+
+    // get precomputed positions of entries
+    // see set_matrix_slot
+    const int *element_mat_slot_ptr = element_mat_slot_vec[indx_d].data();
+    const int *element_mat_row_ptr = element_mat_row_vec[indx_d].data();
+
     // iterate for each domain element
+    #ifdef _OPENMP
+    #pragma omp parallel for
+    #endif
     for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
     {
 
-        // get global ID of points around element
-        int p0_gid = mesh_ptr->element_p0_gid_vec[element_did];
-        int p1_gid = mesh_ptr->element_p1_gid_vec[element_did];
-
-        // get domain ID of points
+        // get domain ID of points around element
         // used for getting properties and integrals
-        int p0_did = mesh_ptr->point_gid_to_did_map[p0_gid];
-        int p1_did = mesh_ptr->point_gid_to_did_map[p1_gid];
+        int p0_did = mesh_ptr->element_p0_did_vec[element_did];
+        int p1_did = mesh_ptr->element_p1_did_vec[element_did];
         int did_arr[2] = {p0_did, p1_did};
 
         // get diffusion coefficient of points around element
@@ -187,29 +302,26 @@ void PhysicsSteadyDiffusion::matrix_fill_domain
         double gencoeff_p1 = generationcoefficient_ptr->point_value_vec[p1_did];
         double gencoeff_arr[2] = {gencoeff_p0, gencoeff_p1};
 
-        // calculate a_mat coefficients
-        // matrix row = start_row of test function (physics) + field ID of variable
-        // matrix column = start_column of variable + field ID of variable
-
-        // get field ID of value points
-        // used for getting matrix rows and columns
-        int p0_fid = value_field_ptr->point_gid_to_fid_map[p0_gid];
-        int p1_fid = value_field_ptr->point_gid_to_fid_map[p1_gid];
-        int fid_arr[2] = {p0_fid, p1_fid};
-
         // calculate a_mat coefficients
         for (int indx_i = 0; indx_i < 2; indx_i++){
         for (int indx_j = 0; indx_j < 2; indx_j++){
-            int mat_row = start_row + fid_arr[indx_i];
-            int mat_col = value_field_ptr->start_col + fid_arr[indx_j];
-            a_mat.coeffRef(mat_row, mat_col) += diffcoeff_arr[indx_i]*integral_ptr->integral_div_Ni_dot_div_Nj_vec[element_did][indx_i][indx_j];
+            int mat_slot = element_mat_slot_ptr[4*element_did + 2*indx_i + indx_j];
+            double a_value = diffcoeff_arr[indx_i]*integral_ptr->integral_div_Ni_dot_div_Nj_vec[element_did][indx_i][indx_j];
+            #ifdef _OPENMP
+            #pragma omp atomic
+            #endif
+            a_value_ptr[mat_slot] += a_value;
         }}
 
         // calculate b_vec coefficients
         for (int indx_i = 0; indx_i < 2; indx_i++)
         {
-            int mat_row = start_row + fid_arr[indx_i];
-            b_vec.coeffRef(mat_row) += gencoeff_arr[indx_i]*integral_ptr->integral_Ni_vec[element_did][indx_i];
+            int mat_row = element_mat_row_ptr[2*element_did + indx_i];
+            double b_value = gencoeff_arr[indx_i]*integral_ptr->integral_Ni_vec[element_did][indx_i];
+            #ifdef _OPENMP
+            #pragma omp atomic
+            #endif
+            b_value_ptr[mat_row] += b_value;
         }
 
     }
@@ -218,129 +330,439 @@ void PhysicsSteadyDiffusion::matrix_fill_domain
     for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_flux_domain; boundary_id++)
     {
 
-        // get global ID of element
-        int ea_gid = boundary_ptr->element_flux_gid_vec[boundary_id];
-
-        // get domain ID of element
-        // used for getting global ID of points
-        int ea_did = mesh_ptr->element_gid_to_did_map[ea_gid];
-
-        // get global ID of points
-        int p0_gid = mesh_ptr->element_p0_gid_vec[ea_did];
-        int p1_gid = mesh_ptr->element_p1_gid_vec[ea_did];
-
-        // get local ID of point where boundary is applied
-        int pa_lid = boundary_ptr->element_flux_pa_lid_vec[boundary_id];  // 0 or 1
-
         // identify boundary type
-        int config_id = boundary_ptr->element_flux_boundaryconfig_id_vec[boundary_id];
-        BoundaryConfigStruct boundaryconfig = boundary_ptr->boundaryconfig_vec[config_id];
+        // types and parameters are resolved in BoundaryLine2 when BCs are set
+        int boundary_type = boundary_ptr->element_flux_type_vec[boundary_id];
+        const double *parameter_ptr = &boundary_ptr->element_flux_parameter_vec[2*boundary_id];
 
-        // get field ID of value points
-        // used for getting matrix rows and columns
-        int p0_fid = value_field_ptr->point_gid_to_fid_map[p0_gid];
-        int p1_fid = value_field_ptr->point_gid_to_fid_map[p1_gid];
-        int fid_arr[2] = {p0_fid, p1_fid};
+        // get matrix row where boundary is applied
+        // see set_matrix_slot
+        int mat_row = element_flux_mat_row_vec[indx_d][boundary_id];
 
         // apply boundary condition
-        if (boundaryconfig.type_str == "neumann")
+        if (boundary_type == boundary_type_neumann)
         {
             // add to b_vec
-            int mat_row = start_row + fid_arr[pa_lid];
-            b_vec.coeffRef(mat_row) += boundaryconfig.parameter_vec[0];
+            b_vec.coeffRef(mat_row) += parameter_ptr[0];
         }
-        else if (boundaryconfig.type_str == "robin")
+        else if (boundary_type == boundary_type_robin)
         {
             // add to a_mat and b_vec
-            int mat_row = start_row + fid_arr[pa_lid];
-            int mat_col = value_field_ptr->start_col + fid_arr[pa_lid];
-            b_vec.coeffRef(mat_row) += boundaryconfig.parameter_vec[0];
-            a_mat.coeffRef(mat_row, mat_col) += -boundaryconfig.parameter_vec[1];
+            int mat_slot = element_flux_mat_slot_vec[indx_d][boundary_id];
+            b_vec.coeffRef(mat_row) += parameter_ptr[0];
+            a_value_ptr[mat_slot] += -parameter_ptr[1];
         }
         
     }
 
     // clear rows with value boundary elements
+    // positions of entries in these rows are precomputed in set_matrix_slot
+    for (auto mat_slot : element_value_row_mat_slot_vec[indx_d])
+    {
+        a_value_ptr[mat_slot] = 0.;
+    }
+    for (auto mat_row : element_value_mat_row_vec[indx_d])
+    {
+        // -1 values indicate invalid points
+        if (mat_row != -1)
+        {
+            b_value_ptr[mat_row] = 0.;
+        }
+    }
+
+    // iterate for each value boundary element
     for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_value_domain; boundary_id++)
     {
 
-        // get global ID of element
-        int ea_gid = boundary_ptr->element_value_gid_vec[boundary_id];
+        // identify boundary type
+        // types and parameters are resolved in BoundaryLine2 when BCs are set
+        int boundary_type = boundary_ptr->element_value_type_vec[boundary_id];
+        const double *parameter_ptr = &boundary_ptr->element_value_parameter_vec[boundary_id];
 
-        // get domain ID of element
-        // used for getting global ID of points
-        int ea_did = mesh_ptr->element_gid_to_did_map[ea_gid];
+        // get matrix row where boundary is applied
+        // see set_matrix_slot
+        int mat_row = element_value_mat_row_vec[indx_d][boundary_id];
 
-        // get global ID of points
-        int p0_gid = mesh_ptr->element_p0_gid_vec[ea_did];
-        int p1_gid = mesh_ptr->element_p1_gid_vec[ea_did];
+        // apply boundary condition
+        if (boundary_type == boundary_type_dirichlet)
+        {
 
-        // get local ID of point where boundary is applied
-        int pa_lid = boundary_ptr->element_value_pa_lid_vec[boundary_id];  // 0 or 1
+            // set a_mat and b_vec
+            // -1 values indicate invalid points
+            int mat_slot = element_value_mat_slot_vec[indx_d][boundary_id];
+            if (mat_row != -1)
+            {
+                a_value_ptr[mat_slot] += 1.;
+                b_vec.coeffRef(mat_row) += parameter_ptr[0];
+            }
 
-        // get field ID of value points
-        // used for getting matrix rows and columns
-        int p0_fid = value_field_ptr->point_gid_to_fid_map[p0_gid];
-        int p1_fid = value_field_ptr->point_gid_to_fid_map[p1_gid];
-        int fid_arr[2] = {p0_fid, p1_fid};
+        }
 
-        // erase entire row
-        // -1 values indicate invalid points
-        if (pa_lid != -1)
+    }
+
+}
+
+void PhysicsSteadyDiffusion::matrix_fill_jacobian(Eigen::SparseMatrix<double> &a_mat, Eigen::VectorXd &b_vec, Eigen::VectorXd &x_vec)
+{
+    /*
+
+    Adds the derivatives of the generation coefficient to the matrix equation for Newton iterations.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+    b_vec : Eigen::VectorXd
+        b in Ax = b.
+    x_vec : Eigen::VectorXd
+        x in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Must be called after matrix_fill.
+    The generation term adds c(x) * integral_Ni to b, so the Jacobian of Ax - b is A - D, where D = d(b)/dx.
+    A Newton step solves (A - D) x_new = b - D x, so -D is added to A and -D x is added to b.
+
+    */
+
+    // derivatives are stored and filled up in the base class
+    generation_jacobian_fill(a_mat, b_vec, x_vec, mesh_field_ptr, integral_field_ptr);
+
+}
+
+void PhysicsSteadyDiffusion::set_generation_derivative(VariableField &variable_field_in, ScalarField &derivative_field_in)
+{
+    /*
+
+    Sets the derivative of the generation coefficient with respect to a variable.
+
+    Arguments
+    =========
+    variable_field_in : VariableField
+        Variable v that the generation coefficient c depends on.
+        May be the variable solved for by this physics or one solved for by another physics in the same matrix equation.
+    derivative_field_in : ScalarField
+        dc/dv at each point.
+        Must be updated along with the generation coefficient in each iteration.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Must be called before the physics is loaded into a matrix equation, since the derivatives add entries to A.
+    The derivatives are only used if Newton iterations are enabled in the matrix equation.
+    Derivatives with respect to variables outside of the matrix equation are removed, and the matrix equation is marked invalid (see check_derivative_variable).
+    Domains without dc/dv in derivative_field_in and points where the variable is not defined are skipped.
+
+    */
+
+    derivative_variable_field_ptr_vec.push_back(&variable_field_in);
+    derivative_field_ptr_vec.push_back(&derivative_field_in);
+
+}
+
+void PhysicsSteadyDiffusion::set_dirichlet_symmetric(bool is_dirichlet_symmetric_in)
+{
+    /*
+
+    Sets whether value BCs are also eliminated from the columns of A to keep A symmetric.
+
+    Arguments
+    =========
+    is_dirichlet_symmetric_in : bool
+        true if value BCs are eliminated from both rows and columns of A.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    By default, the rows of value BCs are replaced with x = value, which makes A nonsymmetric.
+    If enabled, the entries of A in the columns of value BCs are also moved to b as -A_ij * value.
+    This is done in matrix_fill_elimination, after all physics in the matrix equation have filled up A and b.
+    The solution is the same, and A is symmetric if the diffusion coefficient is uniform in each element and the other physics are symmetric.
+    This allows the use of MatrixSolverLDLT or MatrixSolverIterative with "cg".
+    These solvers check that A is symmetric and fail (get_is_converged returns false) if it is not.
+
+    */
+
+    is_dirichlet_symmetric = is_dirichlet_symmetric_in;
+
+}
+
+void PhysicsSteadyDiffusion::matrix_pattern(VectorTriplet &a_triplet_vec)
+{
+    /*
+
+    Adds the entries of A that are filled up by the physics to a vector of triplets.
+
+    Arguments
+    =========
+    a_triplet_vec : VectorTriplet
+        vector of (row, column, value) triplets of A.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    The values of the triplets are zero.
+    This is used to generate the sparsity pattern of A before it is filled up.
+
+    */
+
+    // iterate through each domain covered by the mesh
+    for (int indx_d = 0; indx_d < static_cast<int>(mesh_field_ptr->mesh_l2_ptr_vec.size()); indx_d++)
+    {
+
+        // subset the mesh
+        MeshLine2 *mesh_ptr = mesh_field_ptr->mesh_l2_ptr_vec[indx_d];
+
+        // iterate for each domain element
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
         {
-            int mat_row = start_row + fid_arr[pa_lid];
-            a_mat.row(mat_row) *= 0.;
-            b_vec.coeffRef(mat_row) = 0.;
+
+            // get field ID of value points
+            int p0_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p0_gid_vec[element_did]];
+            int p1_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p1_gid_vec[element_did]];
+            int fid_arr[2] = {p0_fid, p1_fid};
+
+            // add entries of element
+            for (int indx_i = 0; indx_i < 2; indx_i++){
+            for (int indx_j = 0; indx_j < 2; indx_j++){
+                int mat_row = start_row + fid_arr[indx_i];
+                int mat_col = value_field_ptr->start_col + fid_arr[indx_j];
+                a_triplet_vec.emplace_back(mat_row, mat_col, 0.);
+            }}
+
         }
 
     }
 
-    // iterate for each value boundary element
-    for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_value_domain; boundary_id++)
+    // add entries of derivatives of generation coefficient
+    generation_jacobian_pattern(a_triplet_vec, mesh_field_ptr, value_field_ptr, start_row);
+
+}
+
+void PhysicsSteadyDiffusion::set_matrix_slot(Eigen::SparseMatrix<double> &a_mat)
+{
+    /*
+
+    Stores the positions of the entries filled up by the physics in the compressed storage of A.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    A must be compressed and contain the entries added in matrix_pattern.
+    The positions are used in matrix_fill to add entries to A without searching for them.
+
+    */
+
+    // clear positions
+    element_mat_slot_vec.clear();
+    element_mat_row_vec.clear();
+    element_flux_mat_slot_vec.clear();
+    element_flux_mat_row_vec.clear();
+    element_value_mat_slot_vec.clear();
+    element_value_mat_row_vec.clear();
+    element_value_row_mat_slot_vec.clear();
+    element_value_col_mat_slot_vec.clear();
+    element_value_col_mat_row_vec.clear();
+    element_value_col_boundary_id_vec.clear();
+
+    // iterate through each domain covered by the mesh
+    for (int indx_d = 0; indx_d < static_cast<int>(mesh_field_ptr->mesh_l2_ptr_vec.size()); indx_d++)
     {
 
-        // get global ID of element
-        int ea_gid = boundary_ptr->element_value_gid_vec[boundary_id];
+        // subset the mesh and boundary
+        MeshLine2 *mesh_ptr = mesh_field_ptr->mesh_l2_ptr_vec[indx_d];
+        BoundaryLine2 *boundary_ptr = boundary_field_ptr->boundary_l2_ptr_vec[indx_d];
 
-        // get domain ID of element
-        // used for getting global ID of points
-        int ea_did = mesh_ptr->element_gid_to_did_map[ea_gid];
+        // initialize positions in this domain
+        VectorInt element_mat_slot_part_vec(4*mesh_ptr->num_element_domain);
+        VectorInt element_mat_row_part_vec(2*mesh_ptr->num_element_domain);
+        VectorInt element_flux_mat_slot_part_vec(boundary_ptr->num_element_flux_domain);
+        VectorInt element_flux_mat_row_part_vec(boundary_ptr->num_element_flux_domain);
+        VectorInt element_value_mat_slot_part_vec(boundary_ptr->num_element_value_domain);
+        VectorInt element_value_mat_row_part_vec(boundary_ptr->num_element_value_domain);
+        VectorInt element_value_row_mat_slot_part_vec;
+
+        // iterate for each domain element
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
+        {
 
-        // get global ID of points
-        int p0_gid = mesh_ptr->element_p0_gid_vec[ea_did];
-        int p1_gid = mesh_ptr->element_p1_gid_vec[ea_did];
+            // get field ID of value points
+            int p0_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p0_gid_vec[element_did]];
+            int p1_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p1_gid_vec[element_did]];
+            int fid_arr[2] = {p0_fid, p1_fid};
 
-        // get local ID of point where boundary is applied
-        int pa_lid = boundary_ptr->element_value_pa_lid_vec[boundary_id];  // 0 or 1
-        
-        // identify boundary type
-        int config_id = boundary_ptr->element_value_boundaryconfig_id_vec[boundary_id];
-        BoundaryConfigStruct boundaryconfig = boundary_ptr->boundaryconfig_vec[config_id];
+            // store matrix rows and positions of entries
+            for (int indx_i = 0; indx_i < 2; indx_i++){
+            for (int indx_j = 0; indx_j < 2; indx_j++){
+                int mat_row = start_row + fid_arr[indx_i];
+                int mat_col = value_field_ptr->start_col + fid_arr[indx_j];
+                element_mat_row_part_vec[2*element_did + indx_i] = mat_row;
+                element_mat_slot_part_vec[4*element_did + 2*indx_i + indx_j] = get_matrix_slot(a_mat, mat_row, mat_col);
+            }}
 
-        // get field ID of value points
-        // used for getting matrix rows and columns
-        int p0_fid = value_field_ptr->point_gid_to_fid_map[p0_gid];
-        int p1_fid = value_field_ptr->point_gid_to_fid_map[p1_gid];
-        int fid_arr[2] = {p0_fid, p1_fid};
+        }
 
-        // apply boundary condition
-        if (boundaryconfig.type_str == "dirichlet")
+        // iterate for each flux boundary element
+        for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_flux_domain; boundary_id++)
         {
 
-            // set a_mat and b_vec
-            // -1 values indicate invalid points
+            // get domain ID of element
+            int ea_did = mesh_ptr->element_gid_to_did_map[boundary_ptr->element_flux_gid_vec[boundary_id]];
+
+            // get field ID of value points
+            int p0_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p0_gid_vec[ea_did]];
+            int p1_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p1_gid_vec[ea_did]];
+            int fid_arr[2] = {p0_fid, p1_fid};
+
+            // store position of diagonal entry where boundary is applied
+            int pa_lid = boundary_ptr->element_flux_pa_lid_vec[boundary_id];
             int mat_row = start_row + fid_arr[pa_lid];
             int mat_col = value_field_ptr->start_col + fid_arr[pa_lid];
+            element_flux_mat_slot_part_vec[boundary_id] = get_matrix_slot(a_mat, mat_row, mat_col);
+            element_flux_mat_row_part_vec[boundary_id] = mat_row;
+
+        }
+
+        // iterate for each value boundary element
+        for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_value_domain; boundary_id++)
+        {
+
+            // get domain ID of element
+            int ea_did = mesh_ptr->element_gid_to_did_map[boundary_ptr->element_value_gid_vec[boundary_id]];
+
+            // get field ID of value points
+            int p0_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p0_gid_vec[ea_did]];
+            int p1_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p1_gid_vec[ea_did]];
+            int fid_arr[2] = {p0_fid, p1_fid};
+
+            // store position of diagonal entry where boundary is applied
+            // -1 values indicate invalid points
+            int pa_lid = boundary_ptr->element_value_pa_lid_vec[boundary_id];
+            element_value_mat_slot_part_vec[boundary_id] = -1;
+            element_value_mat_row_part_vec[boundary_id] = -1;
             if (pa_lid != -1)
             {
-                a_mat.coeffRef(mat_row, mat_col) += 1.;
-                b_vec.coeffRef(mat_row) += boundaryconfig.parameter_vec[0];
+                int mat_row = start_row + fid_arr[pa_lid];
+                int mat_col = value_field_ptr->start_col + fid_arr[pa_lid];
+                element_value_mat_slot_part_vec[boundary_id] = get_matrix_slot(a_mat, mat_row, mat_col);
+                element_value_mat_row_part_vec[boundary_id] = mat_row;
+            }
+
+        }
+
+        // mark rows with value BCs
+        std::vector<bool> is_value_row_vec(a_mat.rows(), false);
+        for (auto mat_row : element_value_mat_row_part_vec)
+        {
+            if (mat_row != -1)
+            {
+                is_value_row_vec[mat_row] = true;
+            }
+        }
+
+        // store positions of all entries in rows with value BCs
+        // these rows are cleared before the value BCs are applied
+        for (int mat_col = 0; mat_col < a_mat.outerSize(); mat_col++){
+        for (int mat_slot = a_mat.outerIndexPtr()[mat_col]; mat_slot < a_mat.outerIndexPtr()[mat_col + 1]; mat_slot++){
+            if (is_value_row_vec[a_mat.innerIndexPtr()[mat_slot]])
+            {
+                element_value_row_mat_slot_part_vec.push_back(mat_slot);
+            }
+        }}
+
+        // store positions in this domain
+        element_mat_slot_vec.push_back(element_mat_slot_part_vec);
+        element_mat_row_vec.push_back(element_mat_row_part_vec);
+        element_flux_mat_slot_vec.push_back(element_flux_mat_slot_part_vec);
+        element_flux_mat_row_vec.push_back(element_flux_mat_row_part_vec);
+        element_value_mat_slot_vec.push_back(element_value_mat_slot_part_vec);
+        element_value_mat_row_vec.push_back(element_value_mat_row_part_vec);
+        element_value_row_mat_slot_vec.push_back(element_value_row_mat_slot_part_vec);
+
+    }
+
+    // mark rows with value BCs in all domains
+    std::vector<bool> is_value_row_all_vec(a_mat.rows(), false);
+    for (auto &element_value_mat_row_part_vec : element_value_mat_row_vec){
+    for (auto mat_row : element_value_mat_row_part_vec){
+        if (mat_row != -1)
+        {
+            is_value_row_all_vec[mat_row] = true;
+        }
+    }}
+
+    // iterate through each domain covered by the mesh
+    for (int indx_d = 0; indx_d < static_cast<int>(mesh_field_ptr->mesh_l2_ptr_vec.size()); indx_d++)
+    {
+
+        // subset the boundary
+        BoundaryLine2 *boundary_ptr = boundary_field_ptr->boundary_l2_ptr_vec[indx_d];
+
+        // initialize positions in this domain
+        VectorInt element_value_col_mat_slot_part_vec;
+        VectorInt element_value_col_mat_row_part_vec;
+        VectorInt element_value_col_boundary_id_part_vec;
+
+        // store positions of entries in columns with value BCs outside rows with value BCs in any domain
+        // these entries are moved to b_vec if value BCs are applied symmetrically
+        for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_value_domain; boundary_id++)
+        {
+
+            // skip invalid points
+            int mat_row_value = element_value_mat_row_vec[indx_d][boundary_id];
+            if (mat_row_value == -1)
+            {
+                continue;
+            }
+
+            // iterate through entries in column of the value point
+            // row and column share the field ID of the point
+            int mat_col = value_field_ptr->start_col + mat_row_value - start_row;
+            for (int mat_slot = a_mat.outerIndexPtr()[mat_col]; mat_slot < a_mat.outerIndexPtr()[mat_col + 1]; mat_slot++)
+            {
+                int mat_row = a_mat.innerIndexPtr()[mat_slot];
+                if (!is_value_row_all_vec[mat_row])
+                {
+                    element_value_col_mat_slot_part_vec.push_back(mat_slot);
+                    element_value_col_mat_row_part_vec.push_back(mat_row);
+                    element_value_col_boundary_id_part_vec.push_back(boundary_id);
+                }
             }
 
         }
 
+        // store positions in this domain
+        element_value_col_mat_slot_vec.push_back(element_value_col_mat_slot_part_vec);
+        element_value_col_mat_row_vec.push_back(element_value_col_mat_row_part_vec);
+        element_value_col_boundary_id_vec.push_back(element_value_col_boundary_id_part_vec);
+
     }
 
+    // store positions of Jacobian entries
+    // entries in rows with value BCs in any domain are skipped
+    set_generation_jacobian_slot(a_mat, mesh_field_ptr, value_field_ptr, start_row, is_value_row_all_vec);
+
 }
 
 void PhysicsSteadyDiffusion::set_start_row(int start_row_in)
@@ -406,4 +828,41 @@ std::vector<VariableField*> PhysicsSteadyDiffusion::get_variable_field_ptr_vec()
 
 }
 
+VectorInt PhysicsSteadyDiffusion::get_value_row_vec()
+{
+    /*
+
+    Returns the rows of A where value BCs are applied.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    value_row_vec : VectorInt
+        Rows of A where value BCs are applied.
+
+    Notes
+    =====
+    Must be called after set_matrix_slot.
+    Rows appear once for each value BC applied to them.
+
+    */
+
+    // collect rows of value BCs in each domain
+    // -1 values indicate invalid points
+    VectorInt value_row_vec;
+    for (auto &element_value_mat_row_part_vec : element_value_mat_row_vec){
+    for (auto mat_row : element_value_mat_row_part_vec){
+        if (mat_row != -1)
+        {
+            value_row_vec.push_back(mat_row);
+        }
+    }}
+
+    return value_row_vec;
+
+}
+
 #endif
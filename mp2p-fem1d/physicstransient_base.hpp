@@ -1,8 +1,10 @@
 #ifndef PHYSICSTRANSIENT_BASE
 #define PHYSICSTRANSIENT_BASE
+#include <algorithm>
 #include <vector>
 #include "Eigen/Eigen"
 #include "boundary_field.hpp"
+#include "container_triplet.hpp"
 #include "container_typedef.hpp"
 #include "mesh_field.hpp"
 #include "scalar_field.hpp"
@@ -18,13 +20,26 @@ class PhysicsTransientBase
     Functions
     =========
     matrix_fill : void
-        Fill up the matrix equation Ax = b with entries as dictated by the physics. 
+        Fill up the operators M, K, and f with entries as dictated by the physics.
+        An overload fills up Ax(t+1) = Cx(t) + d for a given dt instead (backward Euler).
+    matrix_fill_boundary : bool
+        Updates the BC entries of K and f after BC parameters are changed.
+    matrix_pattern : void
+        Adds the entries of A that are filled up by the physics to a vector of triplets.
+    set_matrix_slot : void
+        Stores the positions of the entries filled up by the physics in the compressed storage of A.
     set_start_row : void
         Sets the starting row in A and b where entries are filled up.
     get_start_row : int
         Returns the starting row.
     get_variable_field_ptr_vec() : vector<VariableField*>
         Returns the vector containing pointers to VariableField objects tied to this physics.
+    get_boundary_field_ptr() : BoundaryField*
+        Returns the pointer to the BoundaryField object tied to this physics.
+
+    Notes
+    =====
+    Derived physics override the M, K, and f overload of matrix_fill and bring the other overload into scope with a using-declaration.
 
     */
 
@@ -43,13 +58,22 @@ class PhysicsTransientBase
 
     // functions
     virtual void matrix_fill
+    (
+        Eigen::SparseMatrix<double> &m_mat, Eigen::SparseMatrix<double> &k_mat, Eigen::VectorXd &f_vec,
+        Eigen::VectorXd &x_vec, Eigen::VectorXd &x_last_timestep_vec
+    );
+    void matrix_fill
     (
         Eigen::SparseMatrix<double> &a_mat, Eigen::SparseMatrix<double> &c_mat, Eigen::VectorXd &d_vec,
         Eigen::VectorXd &x_vec, Eigen::VectorXd &x_last_timestep_vec, double dt
     );
+    virtual bool matrix_fill_boundary(Eigen::SparseMatrix<double> &k_mat, Eigen::VectorXd &f_vec);
+    virtual void matrix_pattern(VectorTriplet &a_triplet_vec);
+    virtual void set_matrix_slot(Eigen::SparseMatrix<double> &a_mat);
     virtual void set_start_row(int start_row_in);
     virtual int get_start_row();
     virtual std::vector<VariableField*> get_variable_field_ptr_vec();
+    virtual BoundaryField* get_boundary_field_ptr();
 
     // default constructor
     PhysicsTransientBase()
@@ -57,8 +81,48 @@ class PhysicsTransientBase
 
     }
 
+    protected:
+    int get_matrix_slot(Eigen::SparseMatrix<double> &a_mat, int mat_row, int mat_col);
+
 };
 
+void PhysicsTransientBase::matrix_fill
+(
+    Eigen::SparseMatrix<double> &m_mat, Eigen::SparseMatrix<double> &k_mat, Eigen::VectorXd &f_vec,
+    Eigen::VectorXd &x_vec, Eigen::VectorXd &x_last_timestep_vec
+)
+{
+    /*
+
+    Fill up the operators M, K, and f of the matrix equation with entries as dictated by the physics. 
+
+    Arguments
+    =========
+    m_mat : Eigen::SparseMatrix<double>
+        M (mass matrix) in M dx/dt + Kx = f.
+    k_mat : Eigen::SparseMatrix<double>
+        K (stiffness matrix) in M dx/dt + Kx = f.
+    f_vec : Eigen::VectorXd
+        f (load vector) in M dx/dt + Kx = f.
+    x_vec : Eigen::VectorXd
+        x at the current iteration of the timestep.
+    x_last_timestep_vec : Eigen::VectorXd
+        x at the last timestep.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    The matrix equation Ax = b of each timestep or stage is formed from these by MatrixEquationTransient.
+    A = coeff_m * M + coeff_k * K, where coeff_m and coeff_k depend on the time integration scheme and dt.
+    M, K, and f do not depend on dt, so they do not need to be filled up again when only dt changes.
+
+    */
+
+}
+
 void PhysicsTransientBase::matrix_fill
 (
     Eigen::SparseMatrix<double> &a_mat, Eigen::SparseMatrix<double> &c_mat, Eigen::VectorXd &d_vec,
@@ -88,6 +152,93 @@ void PhysicsTransientBase::matrix_fill
     =======
     (none)
 
+    Notes
+    =====
+    This is the interface used before the operators M, K, and f were filled up separately.
+    M, K, and f are filled up using the other overload and added as A += M/dt + K, C += M/dt, and d += f (backward Euler).
+    A and C must be compressed and have the sparsity pattern set up using matrix_pattern and set_matrix_slot.
+    New code should use MatrixEquationTransient, which reuses M, K, and f across timesteps and supports other schemes.
+
+    */
+
+    // fill up operators with the sparsity pattern of A
+    Eigen::SparseMatrix<double> m_mat = a_mat;
+    m_mat.coeffs().setZero();
+    Eigen::SparseMatrix<double> k_mat = m_mat;
+    Eigen::VectorXd f_vec = Eigen::VectorXd::Zero(d_vec.size());
+    matrix_fill(m_mat, k_mat, f_vec, x_vec, x_last_timestep_vec);
+
+    // add operators to matrix equation
+    a_mat.coeffs() += m_mat.coeffs()/dt + k_mat.coeffs();
+    c_mat.coeffs() += m_mat.coeffs()/dt;
+    d_vec += f_vec;
+
+}
+
+bool PhysicsTransientBase::matrix_fill_boundary(Eigen::SparseMatrix<double> &k_mat, Eigen::VectorXd &f_vec)
+{
+    /*
+
+    Updates the BC entries of K and f after BC parameters are changed.
+
+    Arguments
+    =========
+    k_mat : Eigen::SparseMatrix<double>
+        K (stiffness matrix) in M dx/dt + Kx = f.
+    f_vec : Eigen::VectorXd
+        f (load vector) in M dx/dt + Kx = f.
+
+    Returns
+    =======
+    is_k_changed : bool
+        true if entries of K were changed.
+
+    Notes
+    =====
+    Must be called after matrix_fill.
+    Only the contributions of BC elements that changed since the last call to matrix_fill or matrix_fill_boundary are updated.
+    M is not affected by BCs; the rest of K and f is kept.
+
+    */
+
+    return false;
+
+}
+
+void PhysicsTransientBase::matrix_pattern(VectorTriplet &a_triplet_vec)
+{
+    /*
+
+    Adds the entries of A that are filled up by the physics to a vector of triplets.
+
+    Arguments
+    =========
+    a_triplet_vec : VectorTriplet
+        vector of (row, column, value) triplets of A.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+}
+
+void PhysicsTransientBase::set_matrix_slot(Eigen::SparseMatrix<double> &a_mat)
+{
+    /*
+
+    Stores the positions of the entries filled up by the physics in the compressed storage of A.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b, where A = coeff_m * M + coeff_k * K.
+
+    Returns
+    =======
+    (none)
+
     */
 
 }
@@ -155,4 +306,62 @@ std::vector<VariableField*> PhysicsTransientBase::get_variable_field_ptr_vec()
 
 }
 
+BoundaryField* PhysicsTransientBase::get_boundary_field_ptr()
+{
+    /*
+
+    Returns the pointer to the BoundaryField object tied to this physics.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    boundary_field_ptr : BoundaryField*
+        Pointer to BoundaryField object.
+
+    */
+
+    return boundary_field_ptr;
+
+}
+
+int PhysicsTransientBase::get_matrix_slot(Eigen::SparseMatrix<double> &a_mat, int mat_row, int mat_col)
+{
+    /*
+
+    Returns the position of an entry in the compressed storage of A.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b, where A = coeff_m * M + coeff_k * K.
+    mat_row : int
+        Row of the entry.
+    mat_col : int
+        Column of the entry.
+
+    Returns
+    =======
+    mat_slot : int
+        Index of the entry in a_mat.valuePtr().
+        -1 if the entry is not in the sparsity pattern of A.
+
+    */
+
+    // search rows in column (sorted in compressed storage)
+    const int *inner_start_ptr = a_mat.innerIndexPtr() + a_mat.outerIndexPtr()[mat_col];
+    const int *inner_end_ptr = a_mat.innerIndexPtr() + a_mat.outerIndexPtr()[mat_col + 1];
+    const int *inner_ptr = std::lower_bound(inner_start_ptr, inner_end_ptr, mat_row);
+
+    // return position if entry is found
+    if (inner_ptr == inner_end_ptr || *inner_ptr != mat_row)
+    {
+        return -1;
+    }
+    return inner_ptr - a_mat.innerIndexPtr();
+
+}
+
 #endif
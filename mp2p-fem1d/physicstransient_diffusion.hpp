@@ -3,6 +3,7 @@
 #include <vector>
 #include "Eigen/Eigen"
 #include "boundary_field.hpp"
+#include "container_triplet.hpp"
 #include "container_typedef.hpp"
 #include "integral_field.hpp"
 #include "mesh_field.hpp"
@@ -40,12 +41,20 @@ class PhysicsTransientDiffusion : public PhysicsTransientBase
     =========
     matrix_fill : void
         Fill up the matrix equation Ax = b with entries as dictated by the physics. 
+    matrix_fill_boundary : bool
+        Updates the BC entries of K and f after BC parameters are changed.
+    matrix_pattern : void
+        Adds the entries of A that are filled up by the physics to a vector of triplets.
+    set_matrix_slot : void
+        Stores the positions of the entries filled up by the physics in the compressed storage of A.
     set_start_row : void
         Sets the starting row in A and b where entries are filled up.
     get_start_row : int
         Returns the starting row.
     get_variable_field_ptr_vec() : vector<VariableField*>
         Returns the vector containing pointers to VariableField objects tied to this physics.
+    get_boundary_field_ptr() : BoundaryField*
+        Returns the pointer to the BoundaryField object tied to this physics.
 
     */
 
@@ -66,14 +75,37 @@ class PhysicsTransientDiffusion : public PhysicsTransientBase
     // starting row of test functions in matrix equation
     int start_row = -1;
 
+    // positions of entries in the compressed storage of A
+    // outer vector: domain index; inner vector: position of each entry
+    std::vector<VectorInt> element_mat_slot_vec;  // entry (i, j) of element at 4*element_did + 2*i + j
+    std::vector<VectorInt> element_mat_row_vec;  // row of point i of element at 2*element_did + i
+    std::vector<VectorInt> element_flux_mat_slot_vec;  // diagonal entry of each flux BC
+    std::vector<VectorInt> element_flux_mat_row_vec;  // row of each flux BC
+    std::vector<VectorInt> element_value_mat_slot_vec;  // diagonal entry of each value BC
+    std::vector<VectorInt> element_value_mat_row_vec;  // row of each value BC
+    std::vector<VectorInt> element_value_row_mat_slot_vec;  // all entries in rows of value BCs
+    std::vector<bool> is_value_row_vec;  // true for rows with value BCs in any domain
+
+    // BC types and parameters as last applied to K and f
+    // outer vector: domain index; inner vector: copy of the resolved BC data in BoundaryLine2
+    std::vector<VectorInt> element_flux_type_applied_vec;
+    std::vector<VectorDouble> element_flux_parameter_applied_vec;
+    std::vector<VectorInt> element_value_type_applied_vec;
+    std::vector<VectorDouble> element_value_parameter_applied_vec;
+
     // functions
+    using PhysicsTransientBase::matrix_fill;
     void matrix_fill(
-        Eigen::SparseMatrix<double> &a_mat, Eigen::SparseMatrix<double> &c_mat, Eigen::VectorXd &d_vec,
-        Eigen::VectorXd &x_vec, Eigen::VectorXd &x_last_timestep_vec, double dt
+        Eigen::SparseMatrix<double> &m_mat, Eigen::SparseMatrix<double> &k_mat, Eigen::VectorXd &f_vec,
+        Eigen::VectorXd &x_vec, Eigen::VectorXd &x_last_timestep_vec
     );
+    bool matrix_fill_boundary(Eigen::SparseMatrix<double> &k_mat, Eigen::VectorXd &f_vec);
+    void matrix_pattern(VectorTriplet &a_triplet_vec);
+    void set_matrix_slot(Eigen::SparseMatrix<double> &a_mat);
     void set_start_row(int start_row_in);
     int get_start_row();
     std::vector<VariableField*> get_variable_field_ptr_vec();
+    BoundaryField* get_boundary_field_ptr();
 
     // default constructor
     PhysicsTransientDiffusion()
@@ -113,9 +145,8 @@ class PhysicsTransientDiffusion : public PhysicsTransientBase
     private:
     void matrix_fill_domain
     (
-        Eigen::SparseMatrix<double> &a_mat, Eigen::SparseMatrix<double> &c_mat, Eigen::VectorXd &d_vec,
-        Eigen::VectorXd &x_vec, Eigen::VectorXd &x_last_timestep_vec, double dt,
-        MeshLine2 *mesh_ptr, BoundaryLine2 *boundary_ptr, IntegralLine2 *integral_ptr,
+        Eigen::SparseMatrix<double> &m_mat, Eigen::SparseMatrix<double> &k_mat, Eigen::VectorXd &f_vec,
+        int indx_d, MeshLine2 *mesh_ptr, BoundaryLine2 *boundary_ptr, IntegralLine2 *integral_ptr,
         ScalarLine2 *derivativecoefficient_ptr, ScalarLine2 *diffusioncoefficient_ptr, ScalarLine2 *generationcoefficient_ptr
     );
 
@@ -123,35 +154,42 @@ class PhysicsTransientDiffusion : public PhysicsTransientBase
 
 void PhysicsTransientDiffusion::matrix_fill
 (
-    Eigen::SparseMatrix<double> &a_mat, Eigen::SparseMatrix<double> &c_mat, Eigen::VectorXd &d_vec,
-    Eigen::VectorXd &x_vec, Eigen::VectorXd &x_last_timestep_vec, double dt
+    Eigen::SparseMatrix<double> &m_mat, Eigen::SparseMatrix<double> &k_mat, Eigen::VectorXd &f_vec,
+    Eigen::VectorXd &x_vec, Eigen::VectorXd &x_last_timestep_vec
 )
 {
     /*
 
-    Fill up the matrix equation Ax(t+1) = Cx(t) + d with entries as dictated by the physics. 
+    Fill up the operators M, K, and f of the matrix equation with entries as dictated by the physics. 
 
     Arguments
     =========
-    a_mat : Eigen::SparseMatrix<double>
-        A in Ax(t+1) = Cx(t) + d.
-    c_mat : Eigen::SparseMatrix<double>
-        C in Ax(t+1) = Cx(t) + d.
-    d_vec : Eigen::VectorXd
-        d in Ax(t+1) = Cx(t) + d.
+    m_mat : Eigen::SparseMatrix<double>
+        M (mass matrix) in M dx/dt + Kx = f.
+    k_mat : Eigen::SparseMatrix<double>
+        K (stiffness matrix) in M dx/dt + Kx = f.
+    f_vec : Eigen::VectorXd
+        f (load vector) in M dx/dt + Kx = f.
     x_vec : Eigen::VectorXd
-        x(t+1) in Ax(t+1) = Cx(t) + d.
+        x at the current iteration of the timestep (not used; the physics is linear).
     x_last_timestep_vec : Eigen::VectorXd
-        x(t) in Ax(t+1) = Cx(t) + d.
-    dt : double
-        Length of the timestep.
+        x at the last timestep (not used; the physics is linear).
 
     Returns
     =======
     (none)
 
+    Notes
+    =====
+    The matrix equation Ax = b of each timestep or stage is formed from these by MatrixEquationTransient.
+    A = coeff_m * M + coeff_k * K, where coeff_m and coeff_k depend on the time integration scheme and dt.
+
     */
 
+    // operators do not depend on x
+    static_cast<void>(x_vec);
+    static_cast<void>(x_last_timestep_vec);
+
     // iterate through each domain covered by the mesh
     for (int indx_d = 0; indx_d < mesh_field_ptr->mesh_l2_ptr_vec.size(); indx_d++)
     {
@@ -168,9 +206,8 @@ void PhysicsTransientDiffusion::matrix_fill
 
         // determine matrix coefficients for the domain
         matrix_fill_domain(
-            a_mat, c_mat, d_vec,
-            x_vec, x_last_timestep_vec, dt,
-            mesh_ptr, boundary_ptr, integral_ptr,
+            m_mat, k_mat, f_vec,
+            indx_d, mesh_ptr, boundary_ptr, integral_ptr,
             derivativecoefficient_ptr, diffusioncoefficient_ptr, generationcoefficient_ptr
         );
 
@@ -180,25 +217,34 @@ void PhysicsTransientDiffusion::matrix_fill
 
 void PhysicsTransientDiffusion::matrix_fill_domain
 (
-    Eigen::SparseMatrix<double> &a_mat, Eigen::SparseMatrix<double> &c_mat, Eigen::VectorXd &d_vec,
-    Eigen::VectorXd &x_vec, Eigen::VectorXd &x_last_timestep_vec, double dt,
-    MeshLine2 *mesh_ptr, BoundaryLine2 *boundary_ptr, IntegralLine2 *integral_ptr,
+    Eigen::SparseMatrix<double> &m_mat, Eigen::SparseMatrix<double> &k_mat, Eigen::VectorXd &f_vec,
+    int indx_d, MeshLine2 *mesh_ptr, BoundaryLine2 *boundary_ptr, IntegralLine2 *integral_ptr,
     ScalarLine2 *derivativecoefficient_ptr, ScalarLine2 *diffusioncoefficient_ptr, ScalarLine2 *generationcoefficient_ptr
 )
 {
 
+    // get storage of matrix equation
+    // entries are added directly to the compressed storage of m_mat and k_mat
+    double *k_value_ptr = k_mat.valuePtr();
+    double *m_value_ptr = m_mat.valuePtr();
+    double *f_value_ptr = f_vec.data();
+
+    // get precomputed positions of entries
+    // see set_matrix_slot
+    const int *element_mat_slot_ptr = element_mat_slot_vec[indx_d].data();
+    const int *element_mat_row_ptr = element_mat_row_vec[indx_d].data();
+
     // iterate for each domain element
+    #ifdef _OPENMP
+    #pragma omp parallel for
+    #endif
     for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
     {
 
-        // get global ID of points around element
-        int p0_gid = mesh_ptr->element_p0_gid_vec[element_did];
-        int p1_gid = mesh_ptr->element_p1_gid_vec[element_did];
-
-        // get domain ID of points
+        // get domain ID of points around element
         // used for getting properties and integrals
-        int p0_did = mesh_ptr->point_gid_to_did_map[p0_gid];
-        int p1_did = mesh_ptr->point_gid_to_did_map[p1_gid];
+        int p0_did = mesh_ptr->element_p0_did_vec[element_did];
+        int p1_did = mesh_ptr->element_p1_did_vec[element_did];
         int did_arr[2] = {p0_did, p1_did};
 
         // get derivative coefficient of points around element
@@ -216,40 +262,38 @@ void PhysicsTransientDiffusion::matrix_fill_domain
         double gencoeff_p1 = generationcoefficient_ptr->point_value_vec[p1_did];
         double gencoeff_arr[2] = {gencoeff_p0, gencoeff_p1};
 
-        // calculate a_mat coefficients
-        // matrix row = start_row of test function (physics) + field ID of variable
-        // matrix column = start_column of variable + field ID of variable
-
-        // get field ID of temperature points
-        // used for getting matrix rows and columns
-        int p0_fid = value_field_ptr->point_gid_to_fid_map[p0_gid];
-        int p1_fid = value_field_ptr->point_gid_to_fid_map[p1_gid];
-        int fid_arr[2] = {p0_fid, p1_fid};
-
-        // calculate a_mat and c_mat coefficients
+        // calculate m_mat and k_mat coefficients
         for (int indx_i = 0; indx_i < 2; indx_i++){
         for (int indx_j = 0; indx_j < 2; indx_j++){
             
             // calculate matrix indices
-            int mat_row = start_row + fid_arr[indx_i];
-            int mat_col = value_field_ptr->start_col + fid_arr[indx_j];
-
-            // calculate a_mat coefficients
-            a_mat.coeffRef(mat_row, mat_col) += (
-                (dervcoeff_arr[indx_i]/dt)*integral_ptr->integral_Ni_Nj_vec[element_did][indx_i][indx_j] +
-                diffcoeff_arr[indx_i]*integral_ptr->integral_div_Ni_dot_div_Nj_vec[element_did][indx_i][indx_j]
-            );
-
-            // calculate c_mat coefficients
-            c_mat.coeffRef(mat_row, mat_col) += (dervcoeff_arr[indx_i]/dt)*integral_ptr->integral_Ni_Nj_vec[element_did][indx_i][indx_j];
+            int mat_slot = element_mat_slot_ptr[4*element_did + 2*indx_i + indx_j];
+
+            // calculate m_mat coefficients
+            double m_value = dervcoeff_arr[indx_i]*integral_ptr->integral_Ni_Nj_vec[element_did][indx_i][indx_j];
+            #ifdef _OPENMP
+            #pragma omp atomic
+            #endif
+            m_value_ptr[mat_slot] += m_value;
+
+            // calculate k_mat coefficients
+            double k_value = diffcoeff_arr[indx_i]*integral_ptr->integral_div_Ni_dot_div_Nj_vec[element_did][indx_i][indx_j];
+            #ifdef _OPENMP
+            #pragma omp atomic
+            #endif
+            k_value_ptr[mat_slot] += k_value;
 
         }}
 
-        // calculate d_vec coefficients
+        // calculate f_vec coefficients
         for (int indx_i = 0; indx_i < 2; indx_i++)
         {
-            int mat_row = start_row + fid_arr[indx_i];
-            d_vec.coeffRef(mat_row) += gencoeff_arr[indx_i]*integral_ptr->integral_Ni_vec[element_did][indx_i];
+            int mat_row = element_mat_row_ptr[2*element_did + indx_i];
+            double f_value = gencoeff_arr[indx_i]*integral_ptr->integral_Ni_vec[element_did][indx_i];
+            #ifdef _OPENMP
+            #pragma omp atomic
+            #endif
+            f_value_ptr[mat_row] += f_value;
         }
 
     }
@@ -258,128 +302,439 @@ void PhysicsTransientDiffusion::matrix_fill_domain
     for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_flux_domain; boundary_id++)
     {
 
-        // get global ID of element
-        int ea_gid = boundary_ptr->element_flux_gid_vec[boundary_id];
+        // identify boundary type
+        // types and parameters are resolved in BoundaryLine2 when BCs are set
+        int boundary_type = boundary_ptr->element_flux_type_vec[boundary_id];
+        const double *parameter_ptr = &boundary_ptr->element_flux_parameter_vec[2*boundary_id];
 
-        // get domain ID of element
-        // used for getting global ID of points
-        int ea_did = mesh_ptr->element_gid_to_did_map[ea_gid];
+        // get matrix row where boundary is applied
+        // see set_matrix_slot
+        int mat_row = element_flux_mat_row_vec[indx_d][boundary_id];
+
+        // skip rows that are replaced by value BCs in any domain
+        if (is_value_row_vec[mat_row])
+        {
+            continue;
+        }
+
+        // apply boundary condition
+        if (boundary_type == boundary_type_neumann)
+        {
+            // add to f_vec
+            f_vec.coeffRef(mat_row) += parameter_ptr[0];
+        }
+        else if (boundary_type == boundary_type_robin)
+        {
+            // add to k_mat and f_vec
+            int mat_slot = element_flux_mat_slot_vec[indx_d][boundary_id];
+            f_vec.coeffRef(mat_row) += parameter_ptr[0];
+            k_value_ptr[mat_slot] += -parameter_ptr[1];
+        }
+
+    }
 
-        // get global ID of points
-        int p0_gid = mesh_ptr->element_p0_gid_vec[ea_did];
-        int p1_gid = mesh_ptr->element_p1_gid_vec[ea_did];
+    // clear rows with value boundary elements
+    // positions of entries in these rows are precomputed in set_matrix_slot
+    for (auto mat_slot : element_value_row_mat_slot_vec[indx_d])
+    {
+        k_value_ptr[mat_slot] = 0.;
+        m_value_ptr[mat_slot] = 0.;
+    }
+    for (auto mat_row : element_value_mat_row_vec[indx_d])
+    {
+        // -1 values indicate invalid points
+        if (mat_row != -1)
+        {
+            f_value_ptr[mat_row] = 0.;
+        }
+    }
 
-        // get local ID of point where boundary is applied
-        int pa_lid = boundary_ptr->element_flux_pa_lid_vec[boundary_id];  // 0 or 1
+    // iterate for each value boundary element
+    for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_value_domain; boundary_id++)
+    {
 
         // identify boundary type
-        int config_id = boundary_ptr->element_flux_boundaryconfig_id_vec[boundary_id];
-        BoundaryConfigStruct boundaryconfig = boundary_ptr->boundaryconfig_vec[config_id];
+        // types and parameters are resolved in BoundaryLine2 when BCs are set
+        int boundary_type = boundary_ptr->element_value_type_vec[boundary_id];
+        const double *parameter_ptr = &boundary_ptr->element_value_parameter_vec[boundary_id];
 
-        // get field ID of temperature points
-        // used for getting matrix rows and columns
-        int p0_fid = value_field_ptr->point_gid_to_fid_map[p0_gid];
-        int p1_fid = value_field_ptr->point_gid_to_fid_map[p1_gid];
-        int fid_arr[2] = {p0_fid, p1_fid};
+        // get matrix row where boundary is applied
+        // see set_matrix_slot
+        int mat_row = element_value_mat_row_vec[indx_d][boundary_id];
 
         // apply boundary condition
-        if (boundaryconfig.type_str == "neumann")
+        if (boundary_type == boundary_type_dirichlet)
         {
-            // add to d_vec
-            int mat_row = start_row + fid_arr[pa_lid];
-            d_vec.coeffRef(mat_row) += boundaryconfig.parameter_vec[0];
+
+            // set k_mat and f_vec
+            // -1 values indicate invalid points
+            int mat_slot = element_value_mat_slot_vec[indx_d][boundary_id];
+            if (mat_row != -1)
+            {
+                k_value_ptr[mat_slot] += 1.;
+                f_vec.coeffRef(mat_row) += parameter_ptr[0];
+            }
+
         }
-        else if (boundaryconfig.type_str == "robin")
+
+    }
+
+    // store BCs as applied
+    // see matrix_fill_boundary
+    element_flux_type_applied_vec[indx_d] = boundary_ptr->element_flux_type_vec;
+    element_flux_parameter_applied_vec[indx_d] = boundary_ptr->element_flux_parameter_vec;
+    element_value_type_applied_vec[indx_d] = boundary_ptr->element_value_type_vec;
+    element_value_parameter_applied_vec[indx_d] = boundary_ptr->element_value_parameter_vec;
+
+}
+
+bool PhysicsTransientDiffusion::matrix_fill_boundary(Eigen::SparseMatrix<double> &k_mat, Eigen::VectorXd &f_vec)
+{
+    /*
+
+    Updates the BC entries of K and f after BC parameters are changed.
+
+    Arguments
+    =========
+    k_mat : Eigen::SparseMatrix<double>
+        K (stiffness matrix) in M dx/dt + Kx = f.
+    f_vec : Eigen::VectorXd
+        f (load vector) in M dx/dt + Kx = f.
+
+    Returns
+    =======
+    is_k_changed : bool
+        true if entries of K were changed.
+
+    Notes
+    =====
+    Must be called after matrix_fill.
+    Only the contributions of BC elements that changed since the last call to matrix_fill or matrix_fill_boundary are updated.
+    M is not affected by BCs; the rest of K and f is kept.
+
+    */
+
+    // iterate through each domain covered by the mesh
+    bool is_k_changed = false;
+    for (int indx_d = 0; indx_d < static_cast<int>(mesh_field_ptr->mesh_l2_ptr_vec.size()); indx_d++)
+    {
+
+        // subset the boundary
+        BoundaryLine2 *boundary_ptr = boundary_field_ptr->boundary_l2_ptr_vec[indx_d];
+
+        // get storage of matrix equation
+        double *k_value_ptr = k_mat.valuePtr();
+        double *f_value_ptr = f_vec.data();
+
+        // get BCs as applied
+        int *flux_type_applied_ptr = element_flux_type_applied_vec[indx_d].data();
+        double *flux_parameter_applied_ptr = element_flux_parameter_applied_vec[indx_d].data();
+        int *value_type_applied_ptr = element_value_type_applied_vec[indx_d].data();
+        double *value_parameter_applied_ptr = element_value_parameter_applied_vec[indx_d].data();
+
+        // iterate for each flux boundary element
+        for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_flux_domain; boundary_id++)
         {
-            // add to a_mat and b_vec
-            int mat_row = start_row + fid_arr[pa_lid];
-            int mat_col = value_field_ptr->start_col + fid_arr[pa_lid];
-            d_vec.coeffRef(mat_row) += boundaryconfig.parameter_vec[0];
-            a_mat.coeffRef(mat_row, mat_col) += -boundaryconfig.parameter_vec[1];
+
+            // skip unchanged BCs
+            int boundary_type = boundary_ptr->element_flux_type_vec[boundary_id];
+            const double *parameter_ptr = &boundary_ptr->element_flux_parameter_vec[2*boundary_id];
+            double *parameter_applied_ptr = &flux_parameter_applied_ptr[2*boundary_id];
+            int boundary_type_applied = flux_type_applied_ptr[boundary_id];
+            if (
+                boundary_type == boundary_type_applied &&
+                parameter_ptr[0] == parameter_applied_ptr[0] && parameter_ptr[1] == parameter_applied_ptr[1]
+            )
+            {
+                continue;
+            }
+
+            // update contributions unless the row is replaced by value BCs
+            int mat_row = element_flux_mat_row_vec[indx_d][boundary_id];
+            int mat_slot = element_flux_mat_slot_vec[indx_d][boundary_id];
+            if (!is_value_row_vec[mat_row])
+            {
+
+                // remove old contribution
+                if (boundary_type_applied == boundary_type_neumann || boundary_type_applied == boundary_type_robin)
+                {
+                    f_value_ptr[mat_row] -= parameter_applied_ptr[0];
+                }
+                if (boundary_type_applied == boundary_type_robin)
+                {
+                    k_value_ptr[mat_slot] -= -parameter_applied_ptr[1];
+                    is_k_changed = true;
+                }
+
+                // add new contribution
+                if (boundary_type == boundary_type_neumann || boundary_type == boundary_type_robin)
+                {
+                    f_value_ptr[mat_row] += parameter_ptr[0];
+                }
+                if (boundary_type == boundary_type_robin)
+                {
+                    k_value_ptr[mat_slot] += -parameter_ptr[1];
+                    is_k_changed = true;
+                }
+
+            }
+
+            // store BC as applied
+            flux_type_applied_ptr[boundary_id] = boundary_type;
+            parameter_applied_ptr[0] = parameter_ptr[0];
+            parameter_applied_ptr[1] = parameter_ptr[1];
+
+        }
+
+        // iterate for each value boundary element
+        for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_value_domain; boundary_id++)
+        {
+
+            // skip unchanged BCs and invalid points
+            int boundary_type = boundary_ptr->element_value_type_vec[boundary_id];
+            const double *parameter_ptr = &boundary_ptr->element_value_parameter_vec[boundary_id];
+            double *parameter_applied_ptr = &value_parameter_applied_ptr[boundary_id];
+            int boundary_type_applied = value_type_applied_ptr[boundary_id];
+            int mat_row = element_value_mat_row_vec[indx_d][boundary_id];
+            if ((boundary_type == boundary_type_applied && parameter_ptr[0] == parameter_applied_ptr[0]) || mat_row == -1)
+            {
+                continue;
+            }
+
+            // store BC as applied
+            value_type_applied_ptr[boundary_id] = boundary_type;
+            double parameter_old = parameter_applied_ptr[0];
+            parameter_applied_ptr[0] = parameter_ptr[0];
+
+            // remove old contribution
+            int mat_slot = element_value_mat_slot_vec[indx_d][boundary_id];
+            if (boundary_type_applied == boundary_type_dirichlet)
+            {
+                k_value_ptr[mat_slot] -= 1.;
+                f_value_ptr[mat_row] -= parameter_old;
+            }
+
+            // add new contribution
+            if (boundary_type == boundary_type_dirichlet)
+            {
+                k_value_ptr[mat_slot] += 1.;
+                f_value_ptr[mat_row] += parameter_ptr[0];
+            }
+            is_k_changed = is_k_changed || (boundary_type != boundary_type_applied);
+
         }
 
     }
 
-    // clear rows with value boundary elements
-    for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_value_domain; boundary_id++)
-    {
+    return is_k_changed;
 
-        // get global ID of element
-        int ea_gid = boundary_ptr->element_value_gid_vec[boundary_id];
+}
 
-        // get domain ID of element
-        // used for getting global ID of points
-        int ea_did = mesh_ptr->element_gid_to_did_map[ea_gid];
+void PhysicsTransientDiffusion::matrix_pattern(VectorTriplet &a_triplet_vec)
+{
+    /*
 
-        // get global ID of points
-        int p0_gid = mesh_ptr->element_p0_gid_vec[ea_did];
-        int p1_gid = mesh_ptr->element_p1_gid_vec[ea_did];
+    Adds the entries of A that are filled up by the physics to a vector of triplets.
 
-        // get local ID of point where boundary is applied
-        int pa_lid = boundary_ptr->element_value_pa_lid_vec[boundary_id];  // 0 or 1
+    Arguments
+    =========
+    a_triplet_vec : VectorTriplet
+        vector of (row, column, value) triplets of A.
 
-        // get field ID of temperature points
-        // used for getting matrix rows and columns
-        int p0_fid = value_field_ptr->point_gid_to_fid_map[p0_gid];
-        int p1_fid = value_field_ptr->point_gid_to_fid_map[p1_gid];
-        int fid_arr[2] = {p0_fid, p1_fid};
+    Returns
+    =======
+    (none)
 
-        // erase entire row
-        // -1 values indicate invalid points
-        if (pa_lid != -1)
+    Notes
+    =====
+    The values of the triplets are zero.
+    This is used to generate the sparsity pattern of A before it is filled up.
+
+    */
+
+    // iterate through each domain covered by the mesh
+    for (int indx_d = 0; indx_d < static_cast<int>(mesh_field_ptr->mesh_l2_ptr_vec.size()); indx_d++)
+    {
+
+        // subset the mesh
+        MeshLine2 *mesh_ptr = mesh_field_ptr->mesh_l2_ptr_vec[indx_d];
+
+        // iterate for each domain element
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
         {
-            int mat_row = start_row + fid_arr[pa_lid];
-            a_mat.row(mat_row) *= 0.;
-            c_mat.row(mat_row) *= 0.;
-            d_vec.coeffRef(mat_row) = 0.;
+
+            // get field ID of value points
+            int p0_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p0_gid_vec[element_did]];
+            int p1_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p1_gid_vec[element_did]];
+            int fid_arr[2] = {p0_fid, p1_fid};
+
+            // add entries of element
+            for (int indx_i = 0; indx_i < 2; indx_i++){
+            for (int indx_j = 0; indx_j < 2; indx_j++){
+                int mat_row = start_row + fid_arr[indx_i];
+                int mat_col = value_field_ptr->start_col + fid_arr[indx_j];
+                a_triplet_vec.emplace_back(mat_row, mat_col, 0.);
+            }}
+
         }
 
     }
 
-    // iterate for each value boundary element
-    for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_value_domain; boundary_id++)
+}
+
+void PhysicsTransientDiffusion::set_matrix_slot(Eigen::SparseMatrix<double> &a_mat)
+{
+    /*
+
+    Stores the positions of the entries filled up by the physics in the compressed storage of A.
+
+    Arguments
+    =========
+    a_mat : Eigen::SparseMatrix<double>
+        A in Ax = b, where A = coeff_m * M + coeff_k * K.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    M and K have the same sparsity pattern as A, so the positions also apply to them.
+    A must be compressed and contain the entries added in matrix_pattern.
+    The positions are used in matrix_fill to add entries to A without searching for them.
+
+    */
+
+    // clear positions
+    element_mat_slot_vec.clear();
+    element_mat_row_vec.clear();
+    element_flux_mat_slot_vec.clear();
+    element_flux_mat_row_vec.clear();
+    element_value_mat_slot_vec.clear();
+    element_value_mat_row_vec.clear();
+    element_value_row_mat_slot_vec.clear();
+    is_value_row_vec.assign(a_mat.rows(), false);
+    element_flux_type_applied_vec.assign(mesh_field_ptr->mesh_l2_ptr_vec.size(), VectorInt());
+    element_flux_parameter_applied_vec.assign(mesh_field_ptr->mesh_l2_ptr_vec.size(), VectorDouble());
+    element_value_type_applied_vec.assign(mesh_field_ptr->mesh_l2_ptr_vec.size(), VectorInt());
+    element_value_parameter_applied_vec.assign(mesh_field_ptr->mesh_l2_ptr_vec.size(), VectorDouble());
+
+    // iterate through each domain covered by the mesh
+    for (int indx_d = 0; indx_d < static_cast<int>(mesh_field_ptr->mesh_l2_ptr_vec.size()); indx_d++)
     {
 
-        // get global ID of element
-        int ea_gid = boundary_ptr->element_value_gid_vec[boundary_id];
+        // subset the mesh and boundary
+        MeshLine2 *mesh_ptr = mesh_field_ptr->mesh_l2_ptr_vec[indx_d];
+        BoundaryLine2 *boundary_ptr = boundary_field_ptr->boundary_l2_ptr_vec[indx_d];
 
-        // get domain ID of element
-        // used for getting global ID of points
-        int ea_did = mesh_ptr->element_gid_to_did_map[ea_gid];
+        // initialize positions in this domain
+        VectorInt element_mat_slot_part_vec(4*mesh_ptr->num_element_domain);
+        VectorInt element_mat_row_part_vec(2*mesh_ptr->num_element_domain);
+        VectorInt element_flux_mat_slot_part_vec(boundary_ptr->num_element_flux_domain);
+        VectorInt element_flux_mat_row_part_vec(boundary_ptr->num_element_flux_domain);
+        VectorInt element_value_mat_slot_part_vec(boundary_ptr->num_element_value_domain);
+        VectorInt element_value_mat_row_part_vec(boundary_ptr->num_element_value_domain);
+        VectorInt element_value_row_mat_slot_part_vec;
+
+        // iterate for each domain element
+        for (int element_did = 0; element_did < mesh_ptr->num_element_domain; element_did++)
+        {
 
-        // get global ID of points
-        int p0_gid = mesh_ptr->element_p0_gid_vec[ea_did];
-        int p1_gid = mesh_ptr->element_p1_gid_vec[ea_did];
+            // get field ID of value points
+            int p0_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p0_gid_vec[element_did]];
+            int p1_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p1_gid_vec[element_did]];
+            int fid_arr[2] = {p0_fid, p1_fid};
 
-        // get local ID of point where boundary is applied
-        int pa_lid = boundary_ptr->element_value_pa_lid_vec[boundary_id];  // 0 or 1
-        
-        // identify boundary type
-        int config_id = boundary_ptr->element_value_boundaryconfig_id_vec[boundary_id];
-        BoundaryConfigStruct boundaryconfig = boundary_ptr->boundaryconfig_vec[config_id];
+            // store matrix rows and positions of entries
+            for (int indx_i = 0; indx_i < 2; indx_i++){
+            for (int indx_j = 0; indx_j < 2; indx_j++){
+                int mat_row = start_row + fid_arr[indx_i];
+                int mat_col = value_field_ptr->start_col + fid_arr[indx_j];
+                element_mat_row_part_vec[2*element_did + indx_i] = mat_row;
+                element_mat_slot_part_vec[4*element_did + 2*indx_i + indx_j] = get_matrix_slot(a_mat, mat_row, mat_col);
+            }}
 
-        // get field ID of temperature points
-        // used for getting matrix rows and columns
-        int p0_fid = value_field_ptr->point_gid_to_fid_map[p0_gid];
-        int p1_fid = value_field_ptr->point_gid_to_fid_map[p1_gid];
-        int fid_arr[2] = {p0_fid, p1_fid};
+        }
 
-        // apply boundary condition
-        if (boundaryconfig.type_str == "dirichlet")
+        // iterate for each flux boundary element
+        for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_flux_domain; boundary_id++)
         {
 
-            // set a_mat and d_vec
-            // -1 values indicate invalid points
+            // get domain ID of element
+            int ea_did = mesh_ptr->element_gid_to_did_map[boundary_ptr->element_flux_gid_vec[boundary_id]];
+
+            // get field ID of value points
+            int p0_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p0_gid_vec[ea_did]];
+            int p1_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p1_gid_vec[ea_did]];
+            int fid_arr[2] = {p0_fid, p1_fid};
+
+            // store position of diagonal entry where boundary is applied
+            int pa_lid = boundary_ptr->element_flux_pa_lid_vec[boundary_id];
             int mat_row = start_row + fid_arr[pa_lid];
             int mat_col = value_field_ptr->start_col + fid_arr[pa_lid];
+            element_flux_mat_slot_part_vec[boundary_id] = get_matrix_slot(a_mat, mat_row, mat_col);
+            element_flux_mat_row_part_vec[boundary_id] = mat_row;
+
+        }
+
+        // iterate for each value boundary element
+        for (int boundary_id = 0; boundary_id < boundary_ptr->num_element_value_domain; boundary_id++)
+        {
+
+            // get domain ID of element
+            int ea_did = mesh_ptr->element_gid_to_did_map[boundary_ptr->element_value_gid_vec[boundary_id]];
+
+            // get field ID of value points
+            int p0_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p0_gid_vec[ea_did]];
+            int p1_fid = value_field_ptr->point_gid_to_fid_map[mesh_ptr->element_p1_gid_vec[ea_did]];
+            int fid_arr[2] = {p0_fid, p1_fid};
+
+            // store position of diagonal entry where boundary is applied
+            // -1 values indicate invalid points
+            int pa_lid = boundary_ptr->element_value_pa_lid_vec[boundary_id];
+            element_value_mat_slot_part_vec[boundary_id] = -1;
+            element_value_mat_row_part_vec[boundary_id] = -1;
             if (pa_lid != -1)
             {
-                a_mat.coeffRef(mat_row, mat_col) += 1.;
-                d_vec.coeffRef(mat_row) += boundaryconfig.parameter_vec[0];
+                int mat_row = start_row + fid_arr[pa_lid];
+                int mat_col = value_field_ptr->start_col + fid_arr[pa_lid];
+                element_value_mat_slot_part_vec[boundary_id] = get_matrix_slot(a_mat, mat_row, mat_col);
+                element_value_mat_row_part_vec[boundary_id] = mat_row;
             }
 
         }
 
+        // mark rows with value BCs
+        // rows are also marked for all domains of the physics
+        std::vector<bool> is_value_row_part_vec(a_mat.rows(), false);
+        for (auto mat_row : element_value_mat_row_part_vec)
+        {
+            if (mat_row != -1)
+            {
+                is_value_row_part_vec[mat_row] = true;
+                is_value_row_vec[mat_row] = true;
+            }
+        }
+
+        // store positions of all entries in rows with value BCs
+        // these rows are cleared before the value BCs are applied
+        for (int mat_col = 0; mat_col < a_mat.outerSize(); mat_col++){
+        for (int mat_slot = a_mat.outerIndexPtr()[mat_col]; mat_slot < a_mat.outerIndexPtr()[mat_col + 1]; mat_slot++){
+            if (is_value_row_part_vec[a_mat.innerIndexPtr()[mat_slot]])
+            {
+                element_value_row_mat_slot_part_vec.push_back(mat_slot);
+            }
+        }}
+
+        // store positions in this domain
+        element_mat_slot_vec.push_back(element_mat_slot_part_vec);
+        element_mat_row_vec.push_back(element_mat_row_part_vec);
+        element_flux_mat_slot_vec.push_back(element_flux_mat_slot_part_vec);
+        element_flux_mat_row_vec.push_back(element_flux_mat_row_part_vec);
+        element_value_mat_slot_vec.push_back(element_value_mat_slot_part_vec);
+        element_value_mat_row_vec.push_back(element_value_mat_row_part_vec);
+        element_value_row_mat_slot_vec.push_back(element_value_row_mat_slot_part_vec);
+
     }
 
 }
@@ -447,4 +802,25 @@ std::vector<VariableField*> PhysicsTransientDiffusion::get_variable_field_ptr_ve
 
 }
 
+BoundaryField* PhysicsTransientDiffusion::get_boundary_field_ptr()
+{
+    /*
+
+    Returns the pointer to the BoundaryField object tied to this physics.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    boundary_field_ptr : BoundaryField*
+        Pointer to BoundaryField object.
+
+    */
+
+    return boundary_field_ptr;
+
+}
+
 #endif
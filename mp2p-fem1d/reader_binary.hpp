@@ -0,0 +1,269 @@
+#ifndef READER_BINARY
+#define READER_BINARY
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "container_binary.hpp"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define READER_BINARY_MMAP
+#endif
+
+class ReaderBinary
+{
+    /*
+
+    Memory-mapped reader for binary files with mesh and boundary data.
+
+    Variables
+    =========
+    file_in_str_in : string
+        Path to binary file.
+
+    Functions
+    =========
+    get_num_value : int
+        Returns the number of values in an array.
+    get_array_int_ptr : const int*
+        Returns a pointer to the values of an integer array.
+    get_array_double_ptr : const double*
+        Returns a pointer to the values of a floating point array.
+
+    Notes
+    =====
+    The layout of the file is described in container_binary.hpp.
+    The file is memory-mapped; the returned pointers refer directly to the mapped file and no values are copied.
+    The pointers are valid only while the reader exists.
+    If memory mapping is not available, the file is read into a buffer instead.
+    Invalid files or arrays are treated as empty (num_array = 0 or nullptr), and is_valid is set to false.
+    Callers must still check that the arrays have the expected types and lengths.
+
+    */
+
+    public:
+
+    // file name
+    std::string file_in_str;
+
+    // file data
+    int64_t file_type = 0;
+    int num_array = 0;
+    bool is_valid = false;  // true if the file and all of its arrays are valid
+    std::vector<BinaryArrayStruct> array_vec;
+
+    // functions
+    int get_num_value(int indx_a);
+    const int* get_array_int_ptr(int indx_a);
+    const double* get_array_double_ptr(int indx_a);
+
+    // default constructor
+    ReaderBinary()
+    {
+
+    }
+
+    // constructor
+    ReaderBinary(std::string file_in_str_in)
+    {
+
+        // store variables
+        file_in_str = file_in_str_in;
+
+        // map file and read table of arrays
+        read_file(file_in_str);
+
+    }
+
+    // destructor
+    ~ReaderBinary()
+    {
+        #ifdef READER_BINARY_MMAP
+        if (is_mmap)
+        {
+            munmap(const_cast<char*>(data_ptr), data_size);
+        }
+        #endif
+    }
+
+    // mapped memory cannot be shared between copies
+    ReaderBinary(const ReaderBinary&) = delete;
+    ReaderBinary& operator=(const ReaderBinary&) = delete;
+
+    private:
+
+    // mapped or buffered file contents
+    const char *data_ptr = nullptr;
+    size_t data_size = 0;
+    bool is_mmap = false;
+    std::vector<char> buffer_vec;
+
+    // functions
+    void read_file(std::string file_in_str);
+
+};
+
+int ReaderBinary::get_num_value(int indx_a)
+{
+    /*
+
+    Returns the number of values in an array.
+
+    Arguments
+    =========
+    indx_a : int
+        Index of array in the file.
+
+    Returns
+    =======
+    num_value : int
+        Number of values in the array (0 if the array does not exist).
+
+    */
+
+    if (indx_a < 0 || indx_a >= num_array)
+    {
+        return 0;
+    }
+    return static_cast<int>(array_vec[indx_a].num_value);
+
+}
+
+const int* ReaderBinary::get_array_int_ptr(int indx_a)
+{
+    /*
+
+    Returns a pointer to the values of an integer array.
+
+    Arguments
+    =========
+    indx_a : int
+        Index of array in the file.
+
+    Returns
+    =======
+    array_ptr : const int*
+        Pointer to the first value (nullptr if the array does not exist or is not an integer array).
+
+    */
+
+    if (indx_a < 0 || indx_a >= num_array || array_vec[indx_a].type != binary_array_int)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const int*>(data_ptr + array_vec[indx_a].offset);
+
+}
+
+const double* ReaderBinary::get_array_double_ptr(int indx_a)
+{
+    /*
+
+    Returns a pointer to the values of a floating point array.
+
+    Arguments
+    =========
+    indx_a : int
+        Index of array in the file.
+
+    Returns
+    =======
+    array_ptr : const double*
+        Pointer to the first value (nullptr if the array does not exist or is not a floating point array).
+
+    */
+
+    if (indx_a < 0 || indx_a >= num_array || array_vec[indx_a].type != binary_array_double)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const double*>(data_ptr + array_vec[indx_a].offset);
+
+}
+
+void ReaderBinary::read_file(std::string file_in_str)
+{
+
+    // map file into memory
+    #ifdef READER_BINARY_MMAP
+    int file_descriptor = open(file_in_str.c_str(), O_RDONLY);
+    if (file_descriptor != -1)
+    {
+        struct stat file_stat;
+        if (fstat(file_descriptor, &file_stat) == 0 && file_stat.st_size > 0)
+        {
+            void *map_ptr = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+            if (map_ptr != MAP_FAILED)
+            {
+                data_ptr = static_cast<const char*>(map_ptr);
+                data_size = file_stat.st_size;
+                is_mmap = true;
+            }
+        }
+        close(file_descriptor);
+    }
+    #endif
+
+    // read file into buffer if mapping is not available
+    if (!is_mmap)
+    {
+        std::ifstream file_in_stream(file_in_str, std::ios::binary | std::ios::ate);
+        if (!file_in_stream)
+        {
+            return;
+        }
+        std::streamsize file_size = file_in_stream.tellg();
+        file_in_stream.seekg(0, std::ios::beg);
+        buffer_vec.resize(file_size);
+        file_in_stream.read(buffer_vec.data(), file_size);
+        data_ptr = buffer_vec.data();
+        data_size = buffer_vec.size();
+    }
+
+    // check header
+    size_t header_size = sizeof(binary_magic_arr) + 2*sizeof(int64_t);
+    if (data_size < header_size || std::memcmp(data_ptr, binary_magic_arr, sizeof(binary_magic_arr)) != 0)
+    {
+        return;
+    }
+
+    // read file type and number of arrays
+    int64_t num_array_file = 0;
+    std::memcpy(&file_type, data_ptr + sizeof(binary_magic_arr), sizeof(int64_t));
+    std::memcpy(&num_array_file, data_ptr + sizeof(binary_magic_arr) + sizeof(int64_t), sizeof(int64_t));
+    // sizes are compared by division so that corrupt counts cannot overflow
+    if (num_array_file < 0 || static_cast<uint64_t>(num_array_file) > (data_size - header_size)/sizeof(BinaryArrayStruct))
+    {
+        return;
+    }
+
+    // read table of arrays
+    // arrays that do not fit inside the file are treated as empty
+    is_valid = true;
+    array_vec.resize(num_array_file);
+    std::memcpy(array_vec.data(), data_ptr + header_size, num_array_file*sizeof(BinaryArrayStruct));
+    for (auto &array : array_vec)
+    {
+        uint64_t value_size = (array.type == binary_array_int) ? sizeof(int32_t) : sizeof(double);
+        bool is_array_valid = (
+            (array.type == binary_array_int || array.type == binary_array_double) &&
+            array.num_value >= 0 && array.offset >= 0 && array.offset % 8 == 0 &&
+            static_cast<uint64_t>(array.offset) <= data_size &&
+            static_cast<uint64_t>(array.num_value) <= (data_size - array.offset)/value_size
+        );
+        if (!is_array_valid)
+        {
+            array.num_value = 0;
+            array.offset = 0;
+            is_valid = false;
+        }
+    }
+    num_array = num_array_file;
+
+}
+
+#endif
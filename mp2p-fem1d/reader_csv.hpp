@@ -0,0 +1,243 @@
+#ifndef READER_CSV
+#define READER_CSV
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "container_typedef.hpp"
+
+class ReaderCSV
+{
+    /*
+
+    Bulk reader for CSV files with numeric values.
+
+    Variables
+    =========
+    file_in_str_in : string
+        Path to CSV file.
+
+    Functions
+    =========
+    get_value : double
+        Returns the value at a given row and column.
+    get_value_int : int
+        Returns the value at a given row and column as an integer.
+
+    Notes
+    =====
+    The first line of the file is treated as a header and is skipped.
+    The number of columns is taken from the header.
+    The whole file is read at once and parsed using std::from_chars.
+    Integers may be written as floating point numbers (e.g., "1.0"); these are truncated when read as integers.
+    A leading '+' is accepted, as in std::stod.
+    Empty lines are skipped.
+    Files that cannot be opened or have missing or non-numeric values are reported on stderr.
+    These are treated as empty (num_row = 0) and is_valid is set to false.
+
+    */
+
+    public:
+
+    // file name
+    std::string file_in_str;
+
+    // parsed data
+    // value at row i and column j is at value_vec[i*num_column + j]
+    int num_row = 0;
+    int num_column = 0;
+    VectorDouble value_vec;
+    bool is_valid = false;  // true if the file was read without errors
+
+    // functions
+    double get_value(int row, int column);
+    int get_value_int(int row, int column);
+
+    // default constructor
+    ReaderCSV()
+    {
+
+    }
+
+    // constructor
+    ReaderCSV(std::string file_in_str_in)
+    {
+
+        // store variables
+        file_in_str = file_in_str_in;
+
+        // read and parse file
+        read_file(file_in_str);
+
+    }
+
+    private:
+    void read_file(std::string file_in_str);
+
+};
+
+double ReaderCSV::get_value(int row, int column)
+{
+    /*
+
+    Returns the value at a given row and column.
+
+    Arguments
+    =========
+    row : int
+        Row index (excluding header).
+    column : int
+        Column index.
+
+    Returns
+    =======
+    value : double
+        Value at the given row and column.
+
+    */
+
+    return value_vec[row*num_column + column];
+
+}
+
+int ReaderCSV::get_value_int(int row, int column)
+{
+    /*
+
+    Returns the value at a given row and column as an integer.
+
+    Arguments
+    =========
+    row : int
+        Row index (excluding header).
+    column : int
+        Column index.
+
+    Returns
+    =======
+    value : int
+        Value at the given row and column.
+
+    */
+
+    return static_cast<int>(value_vec[row*num_column + column]);
+
+}
+
+void ReaderCSV::read_file(std::string file_in_str)
+{
+    /*
+
+    Reads and parses the whole file.
+
+    Arguments
+    =========
+    file_in_str : string
+        Path to CSV file.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Parsing stops at the first missing or non-numeric value; the file is then treated as empty.
+
+    */
+
+    // read whole file into buffer
+    std::ifstream file_in_stream(file_in_str, std::ios::binary | std::ios::ate);
+    if (!file_in_stream)
+    {
+        std::cerr << "ReaderCSV: " << file_in_str << " cannot be opened.\n";
+        return;
+    }
+    std::streamsize file_size = file_in_stream.tellg();
+    file_in_stream.seekg(0, std::ios::beg);
+    std::string buffer_str(file_size, '\0');
+    file_in_stream.read(&buffer_str[0], file_size);
+    file_in_stream.close();
+
+    // get start and end of buffer
+    const char *char_ptr = buffer_str.data();
+    const char *end_ptr = char_ptr + buffer_str.size();
+
+    // get number of columns from header
+    const char *line_end_ptr = std::find(char_ptr, end_ptr, '\n');
+    num_column = 1 + std::count(char_ptr, line_end_ptr, ',');
+    char_ptr = (line_end_ptr == end_ptr) ? end_ptr : line_end_ptr + 1;
+
+    // reserve memory using number of lines as upper bound
+    int num_line = std::count(char_ptr, end_ptr, '\n') + 1;
+    value_vec.reserve(num_line*num_column);
+
+    // iterate for each line
+    while (char_ptr < end_ptr)
+    {
+
+        // find end of line
+        line_end_ptr = std::find(char_ptr, end_ptr, '\n');
+
+        // skip empty lines
+        const char *content_end_ptr = line_end_ptr;
+        if (content_end_ptr > char_ptr && *(content_end_ptr - 1) == '\r')
+        {
+            content_end_ptr--;
+        }
+        if (content_end_ptr == char_ptr)
+        {
+            char_ptr = (line_end_ptr == end_ptr) ? end_ptr : line_end_ptr + 1;
+            continue;
+        }
+
+        // iterate through each value
+        for (int column = 0; column < num_column; column++)
+        {
+
+            // skip leading spaces
+            while (char_ptr < content_end_ptr && (*char_ptr == ' ' || *char_ptr == '\t'))
+            {
+                char_ptr++;
+            }
+
+            // skip leading '+', which std::from_chars does not accept
+            if (char_ptr < content_end_ptr && *char_ptr == '+')
+            {
+                char_ptr++;
+            }
+
+            // parse value
+            // missing or invalid values invalidate the file
+            double value = 0.;
+            std::from_chars_result result = std::from_chars(char_ptr, content_end_ptr, value);
+            if (result.ec != std::errc())
+            {
+                std::cerr << "ReaderCSV: " << file_in_str << " has a missing or non-numeric value in row " << num_row + 1 << ", column " << column + 1 << ".\n";
+                num_row = 0;
+                value_vec.clear();
+                return;
+            }
+            value_vec.push_back(value);
+
+            // move to the next value
+            char_ptr = std::find(char_ptr, content_end_ptr, ',');
+            if (char_ptr < content_end_ptr)
+            {
+                char_ptr++;
+            }
+
+        }
+
+        // count number of rows
+        num_row++;
+
+        // move to next line
+        char_ptr = (line_end_ptr == end_ptr) ? end_ptr : line_end_ptr + 1;
+
+    }
+    is_valid = true;
+
+}
+
+#endif
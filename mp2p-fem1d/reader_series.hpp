@@ -0,0 +1,315 @@
+#ifndef READER_SERIES
+#define READER_SERIES
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "container_series.hpp"
+#include "container_typedef.hpp"
+
+class ReaderSeries
+{
+    /*
+
+    Reader for binary files with the values of a variable or scalar over several timesteps.
+
+    Variables
+    =========
+    file_in_str_in : string
+        Path to binary file.
+
+    Functions
+    =========
+    read_record : VectorDouble
+        Returns the values in a record.
+
+    Notes
+    =====
+    The layout of the file is described in container_series.hpp.
+    The positions of records are taken from the index file.
+    If the index file is missing or does not cover every record in the file (e.g., it is empty or truncated), the records are scanned instead.
+    Invalid files are treated as empty (num_point = 0 and num_record = 0).
+
+    */
+
+    public:
+
+    // file names
+    std::string file_in_str;
+    std::string file_in_index_str;
+
+    // point data
+    int num_point = 0;
+    VectorInt point_gid_vec;
+    VectorDouble point_position_x_vec;
+
+    // records
+    int num_record = 0;
+    std::vector<int64_t> record_ts_vec;  // timesteps are stored as int64
+    std::vector<int64_t> record_offset_vec;
+
+    // functions
+    VectorDouble read_record(int indx_r);
+
+    // default constructor
+    ReaderSeries()
+    {
+
+    }
+
+    // constructor
+    ReaderSeries(std::string file_in_str_in)
+    {
+
+        // store variables
+        file_in_str = file_in_str_in;
+        file_in_index_str = file_in_str_in + ".idx";
+
+        // read point data and positions of records
+        read_header(file_in_str);
+        read_index(file_in_index_str);
+
+    }
+
+    private:
+
+    // position of first record
+    int64_t record_start_offset = 0;
+
+    // functions
+    void read_header(std::string file_in_str);
+    void read_index(std::string file_in_index_str);
+    void decode_compressed(const std::vector<unsigned char> &byte_vec, VectorDouble &value_vec);
+
+};
+
+VectorDouble ReaderSeries::read_record(int indx_r)
+{
+    /*
+
+    Returns the values in a record.
+
+    Arguments
+    =========
+    indx_r : int
+        Index of record (0 for the first timestep written).
+
+    Returns
+    =======
+    value_vec : VectorDouble
+        Values at each point (empty if the record does not exist).
+
+    Notes
+    =====
+    The timestep of the record is record_ts_vec[indx_r].
+
+    */
+
+    // check index
+    VectorDouble value_vec;
+    if (indx_r < 0 || indx_r >= num_record)
+    {
+        return value_vec;
+    }
+
+    // read record header
+    std::ifstream file_in_stream(file_in_str, std::ios::binary);
+    file_in_stream.seekg(record_offset_vec[indx_r]);
+    SeriesRecordStruct record;
+    file_in_stream.read(reinterpret_cast<char*>(&record), sizeof(SeriesRecordStruct));
+    if (!file_in_stream || record.num_value < 0 || record.num_byte < 0)
+    {
+        return value_vec;
+    }
+
+    // read values
+    if (record.encoding == series_encoding_raw)
+    {
+        value_vec.resize(record.num_value);
+        file_in_stream.read(reinterpret_cast<char*>(value_vec.data()), record.num_value*sizeof(double));
+    }
+    else if (record.encoding == series_encoding_compressed)
+    {
+        std::vector<unsigned char> byte_vec(record.num_byte);
+        file_in_stream.read(reinterpret_cast<char*>(byte_vec.data()), record.num_byte);
+        value_vec.resize(record.num_value);
+        decode_compressed(byte_vec, value_vec);
+    }
+
+    // discard incomplete records
+    if (!file_in_stream)
+    {
+        value_vec.clear();
+    }
+
+    return value_vec;
+
+}
+
+void ReaderSeries::read_header(std::string file_in_str)
+{
+
+    // read magic string and number of points
+    std::ifstream file_in_stream(file_in_str, std::ios::binary);
+    char magic_arr[8];
+    int64_t num_point_file = 0;
+    file_in_stream.read(magic_arr, sizeof(magic_arr));
+    file_in_stream.read(reinterpret_cast<char*>(&num_point_file), sizeof(int64_t));
+    if (!file_in_stream || std::memcmp(magic_arr, series_magic_arr, sizeof(series_magic_arr)) != 0 || num_point_file < 0)
+    {
+        return;
+    }
+
+    // read global IDs and x-coordinates
+    VectorInt point_gid_file_vec(num_point_file);
+    VectorDouble point_position_x_file_vec(num_point_file);
+    file_in_stream.read(reinterpret_cast<char*>(point_gid_file_vec.data()), num_point_file*sizeof(int32_t));
+    file_in_stream.seekg((num_point_file % 2)*sizeof(int32_t), std::ios::cur);
+    file_in_stream.read(reinterpret_cast<char*>(point_position_x_file_vec.data()), num_point_file*sizeof(double));
+    if (!file_in_stream)
+    {
+        return;
+    }
+
+    // store point data
+    num_point = num_point_file;
+    point_gid_vec = point_gid_file_vec;
+    point_position_x_vec = point_position_x_file_vec;
+    record_start_offset = file_in_stream.tellg();
+
+}
+
+void ReaderSeries::read_index(std::string file_in_index_str)
+{
+
+    // skip if header is invalid
+    if (record_start_offset == 0)
+    {
+        return;
+    }
+
+    // get size of file
+    std::ifstream file_in_stream(file_in_str, std::ios::binary | std::ios::ate);
+    int64_t file_size = file_in_stream.tellg();
+
+    // read index file
+    // offsets must increase and point to records inside the file
+    std::ifstream file_in_index_stream(file_in_index_str, std::ios::binary);
+    SeriesIndexStruct index_entry;
+    bool is_index_valid = static_cast<bool>(file_in_index_stream);
+    int64_t offset_last = -1;
+    while (file_in_index_stream.read(reinterpret_cast<char*>(&index_entry), sizeof(SeriesIndexStruct)))
+    {
+        if (index_entry.offset < record_start_offset || index_entry.offset <= offset_last || index_entry.offset + static_cast<int64_t>(sizeof(SeriesRecordStruct)) > file_size)
+        {
+            is_index_valid = false;
+            break;
+        }
+        record_ts_vec.push_back(index_entry.ts);
+        record_offset_vec.push_back(index_entry.offset);
+        offset_last = index_entry.offset;
+    }
+
+    // reject partial index entries
+    if (file_in_index_stream.gcount() != 0)
+    {
+        is_index_valid = false;
+    }
+
+    // check that the last indexed record ends at the end of the file
+    // records missing from an empty or truncated index would otherwise be dropped
+    if (is_index_valid)
+    {
+        // records are padded to a multiple of 8 bytes
+        int64_t offset_end = record_start_offset;
+        if (offset_last != -1)
+        {
+            SeriesRecordStruct record;
+            file_in_stream.seekg(offset_last);
+            file_in_stream.read(reinterpret_cast<char*>(&record), sizeof(SeriesRecordStruct));
+            offset_end = -1;
+            if (file_in_stream && record.num_byte >= 0)
+            {
+                offset_end = offset_last + sizeof(SeriesRecordStruct) + (record.num_byte + 7)/8*8;
+            }
+        }
+        is_index_valid = (offset_end == file_size);
+    }
+    file_in_stream.clear();
+
+    // scan records if index cannot be used
+    if (!is_index_valid)
+    {
+        record_ts_vec.clear();
+        record_offset_vec.clear();
+        int64_t offset = record_start_offset;
+        SeriesRecordStruct record;
+        while (offset + static_cast<int64_t>(sizeof(SeriesRecordStruct)) <= file_size)
+        {
+            file_in_stream.seekg(offset);
+            file_in_stream.read(reinterpret_cast<char*>(&record), sizeof(SeriesRecordStruct));
+            if (!file_in_stream || record.num_byte < 0 || offset + static_cast<int64_t>(sizeof(SeriesRecordStruct)) + record.num_byte > file_size)
+            {
+                break;
+            }
+            record_ts_vec.push_back(record.ts);
+            record_offset_vec.push_back(offset);
+            offset += sizeof(SeriesRecordStruct) + (record.num_byte + 7)/8*8;
+        }
+    }
+
+    // count records
+    num_record = record_ts_vec.size();
+
+}
+
+void ReaderSeries::decode_compressed(const std::vector<unsigned char> &byte_vec, VectorDouble &value_vec)
+{
+
+    // run-length decode
+    // see WriterSeries::encode_compressed
+    int num_value = value_vec.size();
+    int num_plane_byte = 8*num_value;
+    std::vector<unsigned char> plane_vec(num_plane_byte, 0);
+    int indx_p = 0;
+    int indx_c = 0;
+    int num_byte = byte_vec.size();
+    while (indx_c < num_byte && indx_p < num_plane_byte)
+    {
+        int control = byte_vec[indx_c++];
+        if (control < 128)
+        {
+            int num_literal = control + 1;
+            for (int indx_l = 0; indx_l < num_literal && indx_c < num_byte && indx_p < num_plane_byte; indx_l++)
+            {
+                plane_vec[indx_p++] = byte_vec[indx_c++];
+            }
+        }
+        else if (indx_c < num_byte)
+        {
+            int num_repeat = control - 125;
+            unsigned char repeat_byte = byte_vec[indx_c++];
+            for (int indx_l = 0; indx_l < num_repeat && indx_p < num_plane_byte; indx_l++)
+            {
+                plane_vec[indx_p++] = repeat_byte;
+            }
+        }
+    }
+
+    // undo delta coding of each plane
+    for (int indx_b = 0; indx_b < 8; indx_b++){
+    for (int indx_v = 1; indx_v < num_value; indx_v++){
+        plane_vec[indx_b*num_value + indx_v] += plane_vec[indx_b*num_value + indx_v - 1];
+    }}
+
+    // unshuffle bytes
+    unsigned char *value_byte_ptr = reinterpret_cast<unsigned char*>(value_vec.data());
+    for (int indx_v = 0; indx_v < num_value; indx_v++){
+    for (int indx_b = 0; indx_b < 8; indx_b++){
+        value_byte_ptr[8*indx_v + indx_b] = plane_vec[indx_b*num_value + indx_v];
+    }}
+
+}
+
+#endif
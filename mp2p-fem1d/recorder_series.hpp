@@ -0,0 +1,401 @@
+#ifndef RECORDER_SERIES
+#define RECORDER_SERIES
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "container_typedef.hpp"
+#include "mesh_line2.hpp"
+#include "scalar_line2.hpp"
+#include "variable_line2.hpp"
+
+class RecorderSeries
+{
+    /*
+
+    Keeps a history of the values of a variable or scalar in memory during transient simulations.
+
+    Variables
+    =========
+    variable_in : VariableLine2 or ScalarLine2
+        Variable or scalar whose values are recorded.
+    num_snapshot_in : int
+        Maximum number of snapshots kept in memory.
+    is_ring_in : bool
+        true if the oldest snapshot is overwritten when the history is full (ring buffer).
+        false if every other snapshot is dropped when the history is full (decimated history).
+
+    Functions
+    =========
+    record : void
+        Stores a snapshot of the current values if the recording criteria are met.
+    set_interval : void
+        Sets the minimum number of timesteps between snapshots.
+    set_change_threshold : void
+        Sets the change in values that triggers a snapshot.
+    get_num_snapshot : int
+        Returns the number of snapshots kept.
+    get_snapshot_ts : int
+        Returns the timestep of a snapshot.
+    get_snapshot_value_ptr : const double*
+        Returns a pointer to the values of a snapshot.
+    output_csv : void
+        Outputs a CSV file with all snapshots.
+
+    Notes
+    =====
+    All snapshots are stored in a single allocation of num_snapshot * num_point_domain values.
+    A snapshot is recorded if either criterion is met:
+        at least ts_interval timesteps have passed since the last snapshot (disabled if ts_interval <= 0)
+        the largest change in any value since the last snapshot is at least change_threshold (disabled if change_threshold <= 0)
+    By default, every call to record stores a snapshot.
+    In a decimated history, ts_interval is doubled each time every other snapshot is dropped.
+    Snapshots are numbered from oldest (0) to newest (get_num_snapshot() - 1).
+
+    */
+
+    public:
+
+    // recorded values
+    MeshLine2 *mesh_ptr;
+    VectorDouble *point_value_ptr;
+    int num_point_domain = 0;
+
+    // history
+    int num_snapshot = 0;  // capacity
+    bool is_ring = true;
+    VectorDouble snapshot_value_vec;  // values of slot s at s*num_point_domain
+    VectorInt snapshot_ts_vec;  // timestep of each slot
+    int snapshot_start = 0;  // slot with the oldest snapshot
+    int snapshot_count = 0;  // number of snapshots kept
+
+    // recording criteria
+    int ts_interval = 1;
+    double change_threshold = 0.;
+
+    // functions
+    void record(int ts);
+    void set_interval(int ts_interval_in);
+    void set_change_threshold(double change_threshold_in);
+    int get_num_snapshot();
+    int get_snapshot_ts(int indx_s);
+    const double* get_snapshot_value_ptr(int indx_s);
+    void output_csv(std::string file_out_str);
+
+    // default constructor
+    RecorderSeries()
+    {
+
+    }
+
+    // constructor for variables
+    RecorderSeries(VariableLine2 &variable_in, int num_snapshot_in, bool is_ring_in)
+    {
+        initialize(variable_in.mesh_ptr, &variable_in.point_value_vec, num_snapshot_in, is_ring_in);
+    }
+
+    // constructor for scalars
+    RecorderSeries(ScalarLine2 &scalar_in, int num_snapshot_in, bool is_ring_in)
+    {
+        initialize(scalar_in.mesh_ptr, &scalar_in.point_value_vec, num_snapshot_in, is_ring_in);
+    }
+
+    private:
+    void initialize(MeshLine2 *mesh_ptr_in, VectorDouble *point_value_ptr_in, int num_snapshot_in, bool is_ring_in);
+    int get_slot(int indx_s);
+    void decimate();
+
+};
+
+void RecorderSeries::record(int ts)
+{
+    /*
+
+    Stores a snapshot of the current values if the recording criteria are met.
+
+    Arguments
+    =========
+    ts : int
+        Timestep number.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Intended to be called after the solution is stored in each timestep.
+    The first call always stores a snapshot.
+
+    */
+
+    // check recording criteria
+    if (snapshot_count > 0)
+    {
+
+        // check number of timesteps since last snapshot
+        int ts_last = snapshot_ts_vec[get_slot(snapshot_count - 1)];
+        bool is_interval = (ts_interval > 0 && ts - ts_last >= ts_interval);
+
+        // check largest change since last snapshot
+        bool is_change = false;
+        if (!is_interval && change_threshold > 0.)
+        {
+            const double *value_last_ptr = get_snapshot_value_ptr(snapshot_count - 1);
+            const double *value_ptr = point_value_ptr->data();
+            for (int point_did = 0; point_did < num_point_domain; point_did++)
+            {
+                if (std::abs(value_ptr[point_did] - value_last_ptr[point_did]) >= change_threshold)
+                {
+                    is_change = true;
+                    break;
+                }
+            }
+        }
+
+        // skip if no criterion is met
+        if (!is_interval && !is_change)
+        {
+            return;
+        }
+
+    }
+
+    // make space if history is full
+    if (snapshot_count == num_snapshot)
+    {
+        if (is_ring)
+        {
+            snapshot_start = (snapshot_start + 1) % num_snapshot;
+            snapshot_count--;
+        }
+        else
+        {
+            decimate();
+        }
+    }
+
+    // copy values into next slot
+    int slot = get_slot(snapshot_count);
+    std::copy(point_value_ptr->begin(), point_value_ptr->end(), snapshot_value_vec.begin() + slot*num_point_domain);
+    snapshot_ts_vec[slot] = ts;
+    snapshot_count++;
+
+}
+
+void RecorderSeries::set_interval(int ts_interval_in)
+{
+    /*
+
+    Sets the minimum number of timesteps between snapshots.
+
+    Arguments
+    =========
+    ts_interval_in : int
+        Number of timesteps (<= 0 to disable this criterion).
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    ts_interval = ts_interval_in;
+
+}
+
+void RecorderSeries::set_change_threshold(double change_threshold_in)
+{
+    /*
+
+    Sets the change in values that triggers a snapshot.
+
+    Arguments
+    =========
+    change_threshold_in : double
+        Largest absolute change in any value since the last snapshot (<= 0 to disable this criterion).
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    change_threshold = change_threshold_in;
+
+}
+
+int RecorderSeries::get_num_snapshot()
+{
+    /*
+
+    Returns the number of snapshots kept.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    snapshot_count : int
+        Number of snapshots kept.
+
+    */
+
+    return snapshot_count;
+
+}
+
+int RecorderSeries::get_snapshot_ts(int indx_s)
+{
+    /*
+
+    Returns the timestep of a snapshot.
+
+    Arguments
+    =========
+    indx_s : int
+        Snapshot number (0 for the oldest).
+
+    Returns
+    =======
+    ts : int
+        Timestep of the snapshot.
+
+    */
+
+    return snapshot_ts_vec[get_slot(indx_s)];
+
+}
+
+const double* RecorderSeries::get_snapshot_value_ptr(int indx_s)
+{
+    /*
+
+    Returns a pointer to the values of a snapshot.
+
+    Arguments
+    =========
+    indx_s : int
+        Snapshot number (0 for the oldest).
+
+    Returns
+    =======
+    value_ptr : const double*
+        Pointer to num_point_domain values (domain ID as input).
+
+    */
+
+    return snapshot_value_vec.data() + get_slot(indx_s)*num_point_domain;
+
+}
+
+void RecorderSeries::output_csv(std::string file_out_str)
+{
+    /*
+
+    Outputs a CSV file with all snapshots.
+
+    Arguments
+    =========
+    file_out_str : string
+        Path to CSV file.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    The file has one row per point; the columns are gid, position_x, and one column per snapshot.
+    The header of each snapshot column is the timestep.
+    The file is formatted in memory and written at once.
+
+    */
+
+    // format header
+    std::ostringstream file_out_buffer;
+    file_out_buffer << "gid,position_x";
+    for (int indx_s = 0; indx_s < snapshot_count; indx_s++)
+    {
+        file_out_buffer << "," << get_snapshot_ts(indx_s);
+    }
+    file_out_buffer << "\n";
+
+    // format values
+    for (int point_did = 0; point_did < num_point_domain; point_did++)
+    {
+        file_out_buffer << mesh_ptr->point_gid_vec[point_did] << ",";
+        file_out_buffer << mesh_ptr->point_position_x_vec[point_did];
+        for (int indx_s = 0; indx_s < snapshot_count; indx_s++)
+        {
+            file_out_buffer << "," << get_snapshot_value_ptr(indx_s)[point_did];
+        }
+        file_out_buffer << "\n";
+    }
+
+    // write to file
+    std::string file_out_content_str = file_out_buffer.str();
+    std::ofstream file_out_stream(file_out_str, std::ios::binary);
+    file_out_stream.write(file_out_content_str.data(), file_out_content_str.size());
+
+}
+
+void RecorderSeries::initialize(MeshLine2 *mesh_ptr_in, VectorDouble *point_value_ptr_in, int num_snapshot_in, bool is_ring_in)
+{
+
+    // store variables
+    mesh_ptr = mesh_ptr_in;
+    point_value_ptr = point_value_ptr_in;
+    num_point_domain = point_value_ptr->size();
+    num_snapshot = (num_snapshot_in > 1) ? num_snapshot_in : 2;
+    is_ring = is_ring_in;
+
+    // allocate history
+    snapshot_value_vec = VectorDouble(num_snapshot*num_point_domain, 0.);
+    snapshot_ts_vec = VectorInt(num_snapshot, 0);
+
+}
+
+int RecorderSeries::get_slot(int indx_s)
+{
+
+    // convert snapshot number into slot
+    return (snapshot_start + indx_s) % num_snapshot;
+
+}
+
+void RecorderSeries::decimate()
+{
+
+    // move snapshots to the front in chronological order
+    // keep snapshots 0, 2, 4, ...
+    int snapshot_count_new = 0;
+    for (int indx_s = 0; indx_s < snapshot_count; indx_s += 2)
+    {
+        int slot_old = get_slot(indx_s);
+        int slot_new = snapshot_count_new;
+        if (slot_old != slot_new)
+        {
+            std::copy(
+                snapshot_value_vec.begin() + slot_old*num_point_domain,
+                snapshot_value_vec.begin() + (slot_old + 1)*num_point_domain,
+                snapshot_value_vec.begin() + slot_new*num_point_domain
+            );
+            snapshot_ts_vec[slot_new] = snapshot_ts_vec[slot_old];
+        }
+        snapshot_count_new++;
+    }
+    snapshot_start = 0;
+    snapshot_count = snapshot_count_new;
+
+    // record half as often
+    if (ts_interval > 0)
+    {
+        ts_interval *= 2;
+    }
+
+}
+
+#endif
@@ -1,8 +1,12 @@
 #ifndef VARIABLE_LINE2
 #define VARIABLE_LINE2
-#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
 #include "mesh_line2.hpp"
 #include "container_typedef.hpp"
+#include "writer_csv.hpp"
+#include "writer_series.hpp"
 
 class VariableLine2
 {
@@ -21,6 +25,12 @@ class VariableLine2
     =========
     output_csv : void
         Outputs a CSV file with the values of the variable.
+    output_binary : void
+        Outputs a binary file with the values of the variable.
+    flush_binary : void
+        Writes buffered records of the binary files kept open by output_binary.
+    close_binary : void
+        Closes the binary files kept open by output_binary.
 
     */
 
@@ -36,6 +46,15 @@ class VariableLine2
     // functions
     void output_csv(std::string file_out_str);
     void output_csv(std::string file_out_base_str, int ts);
+    void output_binary(std::string file_out_str, bool is_compressed);
+    void output_binary(std::string file_out_str, int ts, bool is_compressed);
+    void flush_binary();
+    void close_binary();
+
+    // writers of binary files created by output_binary
+    // key: path to binary file; value: writer with the file kept open
+    // copies of this object share the writers and append to the same files
+    std::map<std::string, std::shared_ptr<WriterSeries>> writer_series_map;
 
     // default constructor
     VariableLine2()
@@ -84,17 +103,9 @@ void VariableLine2::output_csv(std::string file_out_str)
 
     */
 
-    // initialize file stream
-    std::ofstream file_out_stream(file_out_str);
-
     // write to file
-    file_out_stream << "gid,position_x,value\n";
-    for (int point_did = 0; point_did < num_point_domain; point_did++)
-    {
-        file_out_stream << mesh_ptr->point_gid_vec[point_did] << ",";
-        file_out_stream << mesh_ptr->point_position_x_vec[point_did] << ",";
-        file_out_stream << point_value_vec[point_did] << "\n";
-    }
+    WriterCSV writer_csv;
+    writer_csv.write_file(file_out_str, mesh_ptr, point_value_vec);
 
 }
 
@@ -122,34 +133,137 @@ void VariableLine2::output_csv(std::string file_out_base_str, int ts)
 
     */
 
-    // split filename at '*'
-    // will be replaced with timestep later
-    std::vector<std::string> file_out_base_vec;
-    std::stringstream file_out_base_stream(file_out_base_str);
-    std::string string_sub;
-    while(std::getline(file_out_base_stream, string_sub, '*'))
+    // replace '*' with timestep and write to file
+    WriterCSV writer_csv;
+    std::string file_out_str = writer_csv.get_file_out_str(file_out_base_str, ts);
+    writer_csv.write_file(file_out_str, mesh_ptr, point_value_vec);
+
+}
+
+void VariableLine2::output_binary(std::string file_out_str, bool is_compressed)
+{
+    /*
+
+    Outputs a binary file with the values of the variable.
+
+    Arguments
+    =========
+    file_out_str : string
+        Path to binary file.
+    is_compressed : bool
+        true if values are compressed.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    This function is intended to be used with steady-state simulations.
+    The file has a single record with timestep 0 and can be read using ReaderSeries.
+
+    */
+
+    // create file and write values
+    WriterSeries writer_series(file_out_str, is_compressed);
+    writer_series.write_header(mesh_ptr->point_gid_vec, mesh_ptr->point_position_x_vec);
+    writer_series.write_record(point_value_vec, 0);
+
+}
+
+void VariableLine2::output_binary(std::string file_out_str, int ts, bool is_compressed)
+{
+    /*
+
+    Outputs a binary file with the values of the variable.
+
+    Arguments
+    =========
+    file_out_str : string
+        Path to binary file.
+    ts : int
+        Timestep number.
+    is_compressed : bool
+        true if values are compressed.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    This function is intended to be used with transient simulations.
+    All timesteps are appended to a single file as records; an index of the records is written to file_out_str + ".idx".
+    The file is overwritten the first time it is used by this object and appended to afterwards.
+    The file stays open between calls; it can be read using ReaderSeries after flush_binary or close_binary is called or after this object is destroyed.
+
+    */
+
+    // create file if not yet used by this object
+    auto writer_series_iter = writer_series_map.find(file_out_str);
+    if (writer_series_iter == writer_series_map.end())
     {
-        file_out_base_vec.push_back(string_sub);
+        writer_series_iter = writer_series_map.emplace(file_out_str, std::make_shared<WriterSeries>(file_out_str, is_compressed)).first;
+        writer_series_iter->second->write_header(mesh_ptr->point_gid_vec, mesh_ptr->point_position_x_vec);
     }
 
-    // create output filename
-    // replace '*' with timestep
-    std::string file_out_str = file_out_base_vec[0];
-    for (int i = 1; i < file_out_base_vec.size(); i++)
+    // append values
+    WriterSeries &writer_series = *writer_series_iter->second;
+    writer_series.is_compressed = is_compressed;
+    writer_series.write_record(point_value_vec, ts);
+
+}
+
+void VariableLine2::flush_binary()
+{
+    /*
+
+    Writes buffered records of the binary files kept open by output_binary.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    The files stay open, and later calls to output_binary with a timestep append to them.
+
+    */
+
+    for (auto &writer_series_pair : writer_series_map)
     {
-        file_out_str += std::to_string(ts) + file_out_base_vec[i];
+        writer_series_pair.second->flush();
     }
 
-    // initialize file stream
-    std::ofstream file_out_stream(file_out_str);
+}
 
-    // write to file
-    file_out_stream << "gid,position_x,value\n";
-    for (int point_did = 0; point_did < num_point_domain; point_did++)
+void VariableLine2::close_binary()
+{
+    /*
+
+    Closes the binary files kept open by output_binary.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Later calls to output_binary with a timestep open the files again and append to them.
+
+    */
+
+    for (auto &writer_series_pair : writer_series_map)
     {
-        file_out_stream << mesh_ptr->point_gid_vec[point_did] << ",";
-        file_out_stream << mesh_ptr->point_position_x_vec[point_did] << ",";
-        file_out_stream << point_value_vec[point_did] << "\n";
+        writer_series_pair.second->close();
     }
 
 }
@@ -0,0 +1,360 @@
+#ifndef WRITER_ASYNC
+#define WRITER_ASYNC
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "container_typedef.hpp"
+#include "mesh_line2.hpp"
+#include "scalar_line2.hpp"
+#include "variable_line2.hpp"
+#include "writer_csv.hpp"
+
+// output job handled by the background thread of WriterAsync
+struct WriterAsyncJobStruct
+{
+    MeshLine2 *mesh_ptr;  // mesh with point data
+    int buffer_id;  // buffer with snapshot of values
+    std::string file_out_base_str;  // path to CSV file with '*'
+    int ts;  // timestep number
+};
+
+class WriterAsync
+{
+    /*
+
+    Writes CSV files with values of variables or scalars on a background thread.
+
+    Variables
+    =========
+    num_buffer_in : int
+        Number of snapshot buffers (default 4).
+
+    Functions
+    =========
+    output_csv : void
+        Queues a CSV file with the values at a timestep.
+        Accepts a VariableLine2, a ScalarLine2, or a mesh and its point values.
+    wait : void
+        Blocks until all queued files are written.
+
+    Notes
+    =====
+    Values are copied into a pooled buffer when queued; the caller may modify them immediately afterwards.
+    Memory is bounded by the number of buffers; output_csv blocks if all buffers are waiting to be written.
+    Files are written in the order they are queued, with the same format as VariableLine2::output_csv (see WriterCSV).
+    The mesh must not be modified or destroyed until the queued files are written.
+    Queued files are written before the object is destroyed.
+    This header starts a std::thread; it is not included by mp2p_fem1d.hpp and must be included directly.
+    Programs that include it must be linked with -pthread on compilers that require it.
+
+    */
+
+    public:
+
+    // number of buffers
+    int num_buffer = 4;
+
+    // functions
+    void output_csv(MeshLine2 *mesh_ptr, const VectorDouble &point_value_vec, std::string file_out_base_str, int ts);
+    void output_csv(VariableLine2 &variable, std::string file_out_base_str, int ts);
+    void output_csv(ScalarLine2 &scalar, std::string file_out_base_str, int ts);
+    void wait();
+
+    // default constructor
+    WriterAsync()
+    {
+        start_thread();
+    }
+
+    // constructor
+    WriterAsync(int num_buffer_in)
+    {
+        num_buffer = (num_buffer_in > 0) ? num_buffer_in : 1;
+        start_thread();
+    }
+
+    // destructor
+    ~WriterAsync()
+    {
+
+        // write remaining files
+        wait();
+
+        // stop background thread
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            is_stop = true;
+        }
+        job_condition.notify_all();
+        writer_thread.join();
+
+    }
+
+    // thread cannot be shared between copies
+    WriterAsync(const WriterAsync&) = delete;
+    WriterAsync& operator=(const WriterAsync&) = delete;
+
+    private:
+
+    // snapshot buffers
+    std::vector<VectorDouble> buffer_vec;
+    VectorInt buffer_free_id_vec;
+
+    // queue of jobs
+    std::deque<WriterAsyncJobStruct> job_queue;
+    int num_job_active = 0;  // queued or being written
+    bool is_stop = false;
+
+    // synchronization
+    std::mutex queue_mutex;
+    std::condition_variable job_condition;  // signals new jobs or stop
+    std::condition_variable buffer_condition;  // signals freed buffers
+    std::condition_variable idle_condition;  // signals that all jobs are done
+    std::thread writer_thread;
+
+    // functions
+    void start_thread();
+    void run_thread();
+    void write_csv(WriterAsyncJobStruct &job);
+
+};
+
+void WriterAsync::output_csv(MeshLine2 *mesh_ptr, const VectorDouble &point_value_vec, std::string file_out_base_str, int ts)
+{
+    /*
+
+    Queues a CSV file with the values at a timestep.
+
+    Arguments
+    =========
+    mesh_ptr : MeshLine2*
+        Mesh where the values are applied.
+    point_value_vec : VectorDouble
+        Values at each point (domain ID as input).
+    file_out_base_str : string
+        Path to CSV file with base file name.
+    ts : int
+        Timestep number.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    file_out_base_str must have an asterisk '*', which will be replaced with ts.
+
+    */
+
+    // wait for a free buffer
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    buffer_condition.wait(lock, [this]{return !buffer_free_id_vec.empty();});
+    int buffer_id = buffer_free_id_vec.back();
+    buffer_free_id_vec.pop_back();
+    lock.unlock();
+
+    // copy values into buffer
+    // only this thread owns the buffer until the job is queued
+    buffer_vec[buffer_id].assign(point_value_vec.begin(), point_value_vec.end());
+
+    // queue job
+    lock.lock();
+    job_queue.push_back({mesh_ptr, buffer_id, file_out_base_str, ts});
+    num_job_active++;
+    lock.unlock();
+    job_condition.notify_one();
+
+}
+
+void WriterAsync::output_csv(VariableLine2 &variable, std::string file_out_base_str, int ts)
+{
+    /*
+
+    Queues a CSV file with the values of a variable at a timestep.
+
+    Arguments
+    =========
+    variable : VariableLine2
+        Variable with the values to write.
+    file_out_base_str : string
+        Path to CSV file with base file name.
+    ts : int
+        Timestep number.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    file_out_base_str must have an asterisk '*', which will be replaced with ts.
+    The file has the same format as VariableLine2::output_csv.
+
+    */
+
+    output_csv(variable.mesh_ptr, variable.point_value_vec, file_out_base_str, ts);
+
+}
+
+void WriterAsync::output_csv(ScalarLine2 &scalar, std::string file_out_base_str, int ts)
+{
+    /*
+
+    Queues a CSV file with the values of a scalar at a timestep.
+
+    Arguments
+    =========
+    scalar : ScalarLine2
+        Scalar with the values to write.
+    file_out_base_str : string
+        Path to CSV file with base file name.
+    ts : int
+        Timestep number.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    file_out_base_str must have an asterisk '*', which will be replaced with ts.
+    The file has the same format as ScalarLine2::output_csv.
+
+    */
+
+    output_csv(scalar.mesh_ptr, scalar.point_value_vec, file_out_base_str, ts);
+
+}
+
+void WriterAsync::wait()
+{
+    /*
+
+    Blocks until all queued files are written.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    idle_condition.wait(lock, [this]{return num_job_active == 0;});
+
+}
+
+void WriterAsync::start_thread()
+{
+    /*
+
+    Initializes the buffers and starts the background thread.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    // initialize buffers
+    buffer_vec = std::vector<VectorDouble>(num_buffer);
+    for (int buffer_id = 0; buffer_id < num_buffer; buffer_id++)
+    {
+        buffer_free_id_vec.push_back(buffer_id);
+    }
+
+    // start background thread
+    writer_thread = std::thread(&WriterAsync::run_thread, this);
+
+}
+
+void WriterAsync::run_thread()
+{
+    /*
+
+    Writes queued files on the background thread until the writer is stopped.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Files are written outside of the lock, so new files can be queued meanwhile.
+    Remaining jobs are written before the thread returns.
+
+    */
+
+    // process jobs until stopped
+    while (true)
+    {
+
+        // get next job
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        job_condition.wait(lock, [this]{return is_stop || !job_queue.empty();});
+        if (job_queue.empty())
+        {
+            return;  // stopped and no jobs left
+        }
+        WriterAsyncJobStruct job = job_queue.front();
+        job_queue.pop_front();
+        lock.unlock();
+
+        // write file
+        write_csv(job);
+
+        // free buffer and mark job as done
+        lock.lock();
+        buffer_free_id_vec.push_back(job.buffer_id);
+        num_job_active--;
+        bool is_idle = (num_job_active == 0);
+        lock.unlock();
+        buffer_condition.notify_one();
+        if (is_idle)
+        {
+            idle_condition.notify_all();
+        }
+
+    }
+
+}
+
+void WriterAsync::write_csv(WriterAsyncJobStruct &job)
+{
+    /*
+
+    Writes the CSV file of a job.
+
+    Arguments
+    =========
+    job : WriterAsyncJobStruct
+        Job with the mesh, buffer, file name, and timestep.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    // replace '*' with timestep and write to file
+    WriterCSV writer_csv;
+    std::string file_out_str = writer_csv.get_file_out_str(job.file_out_base_str, job.ts);
+    writer_csv.write_file(file_out_str, job.mesh_ptr, buffer_vec[job.buffer_id]);
+
+}
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef WRITER_BINARY
+#define WRITER_BINARY
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "container_binary.hpp"
+#include "container_typedef.hpp"
+
+class WriterBinary
+{
+    /*
+
+    Writer for binary files with mesh and boundary data.
+
+    Variables
+    =========
+    file_type_in : int64_t
+        Type of file (binary_file_mesh or binary_file_boundary).
+
+    Functions
+    =========
+    add_array : void
+        Adds an integer or floating point array to the file.
+    write_file : void
+        Writes the header, table of arrays, and arrays to a file.
+
+    Notes
+    =====
+    The layout of the file is described in container_binary.hpp.
+    Arrays are written in the order they are added; readers refer to them by this index.
+    Only pointers to the arrays are stored; the arrays must exist until write_file is called.
+
+    */
+
+    public:
+
+    // file type
+    int64_t file_type = 0;
+
+    // arrays to be written
+    std::vector<BinaryArrayStruct> array_vec;
+    std::vector<const char*> array_data_ptr_vec;
+
+    // functions
+    void add_array(const VectorInt &value_vec);
+    void add_array(const VectorDouble &value_vec);
+    void write_file(std::string file_out_str);
+
+    // default constructor
+    WriterBinary()
+    {
+
+    }
+
+    // constructor
+    WriterBinary(int64_t file_type_in)
+    {
+        file_type = file_type_in;
+    }
+
+};
+
+void WriterBinary::add_array(const VectorInt &value_vec)
+{
+    /*
+
+    Adds an integer array to the file.
+
+    Arguments
+    =========
+    value_vec : VectorInt
+        Values in the array.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    array_vec.push_back({binary_array_int, static_cast<int64_t>(value_vec.size()), 0});
+    array_data_ptr_vec.push_back(reinterpret_cast<const char*>(value_vec.data()));
+
+}
+
+void WriterBinary::add_array(const VectorDouble &value_vec)
+{
+    /*
+
+    Adds a floating point array to the file.
+
+    Arguments
+    =========
+    value_vec : VectorDouble
+        Values in the array.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    array_vec.push_back({binary_array_double, static_cast<int64_t>(value_vec.size()), 0});
+    array_data_ptr_vec.push_back(reinterpret_cast<const char*>(value_vec.data()));
+
+}
+
+void WriterBinary::write_file(std::string file_out_str)
+{
+    /*
+
+    Writes the header, table of arrays, and arrays to a file.
+
+    Arguments
+    =========
+    file_out_str : string
+        Path to binary file.
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    // compute offsets of arrays
+    // each array starts at a multiple of 8 bytes
+    int64_t num_array = array_vec.size();
+    int64_t offset = sizeof(binary_magic_arr) + 2*sizeof(int64_t) + num_array*sizeof(BinaryArrayStruct);
+    for (auto &array : array_vec)
+    {
+        int64_t value_size = (array.type == binary_array_int) ? sizeof(int32_t) : sizeof(double);
+        offset = (offset + 7)/8*8;
+        array.offset = offset;
+        offset += array.num_value*value_size;
+    }
+
+    // write header and table of arrays
+    std::ofstream file_out_stream(file_out_str, std::ios::binary);
+    file_out_stream.write(binary_magic_arr, sizeof(binary_magic_arr));
+    file_out_stream.write(reinterpret_cast<const char*>(&file_type), sizeof(int64_t));
+    file_out_stream.write(reinterpret_cast<const char*>(&num_array), sizeof(int64_t));
+    file_out_stream.write(reinterpret_cast<const char*>(array_vec.data()), num_array*sizeof(BinaryArrayStruct));
+
+    // write arrays with padding
+    const char padding_arr[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    int64_t position = sizeof(binary_magic_arr) + 2*sizeof(int64_t) + num_array*sizeof(BinaryArrayStruct);
+    for (int indx_a = 0; indx_a < num_array; indx_a++)
+    {
+        int64_t value_size = (array_vec[indx_a].type == binary_array_int) ? sizeof(int32_t) : sizeof(double);
+        file_out_stream.write(padding_arr, array_vec[indx_a].offset - position);
+        file_out_stream.write(array_data_ptr_vec[indx_a], array_vec[indx_a].num_value*value_size);
+        position = array_vec[indx_a].offset + array_vec[indx_a].num_value*value_size;
+    }
+
+}
+
+#endif
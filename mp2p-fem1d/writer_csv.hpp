@@ -0,0 +1,127 @@
+#ifndef WRITER_CSV
+#define WRITER_CSV
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "container_typedef.hpp"
+#include "mesh_line2.hpp"
+
+class WriterCSV
+{
+    /*
+
+    Writer for CSV files with values at the points of a mesh.
+
+    Functions
+    =========
+    get_file_out_str : string
+        Returns the path to a CSV file with the timestep in place of '*'.
+    write_file : void
+        Writes a CSV file with the values at each point of a mesh.
+
+    Notes
+    =====
+    Used by VariableLine2, ScalarLine2, and WriterAsync so that all CSV outputs have the same format.
+    The file has the columns gid, position_x, and value, with one row per domain point.
+
+    */
+
+    public:
+
+    // functions
+    std::string get_file_out_str(std::string file_out_base_str, int ts);
+    void write_file(std::string file_out_str, MeshLine2 *mesh_ptr, const VectorDouble &point_value_vec);
+
+    // default constructor
+    WriterCSV()
+    {
+
+    }
+
+};
+
+std::string WriterCSV::get_file_out_str(std::string file_out_base_str, int ts)
+{
+    /*
+
+    Returns the path to a CSV file with the timestep in place of '*'.
+
+    Arguments
+    =========
+    file_out_base_str : string
+        Path to CSV file with base file name.
+    ts : int
+        Timestep number.
+
+    Returns
+    =======
+    file_out_str : string
+        Path to CSV file.
+
+    Notes
+    =====
+    Each asterisk '*' in file_out_base_str is replaced with ts.
+
+    */
+
+    // split filename at '*'
+    // will be replaced with timestep later
+    std::vector<std::string> file_out_base_vec;
+    std::stringstream file_out_base_stream(file_out_base_str);
+    std::string string_sub;
+    while(std::getline(file_out_base_stream, string_sub, '*'))
+    {
+        file_out_base_vec.push_back(string_sub);
+    }
+
+    // create output filename
+    // replace '*' with timestep
+    std::string file_out_str = file_out_base_vec.empty() ? "" : file_out_base_vec[0];
+    int num_part = file_out_base_vec.size();
+    for (int i = 1; i < num_part; i++)
+    {
+        file_out_str += std::to_string(ts) + file_out_base_vec[i];
+    }
+
+    return file_out_str;
+
+}
+
+void WriterCSV::write_file(std::string file_out_str, MeshLine2 *mesh_ptr, const VectorDouble &point_value_vec)
+{
+    /*
+
+    Writes a CSV file with the values at each point of a mesh.
+
+    Arguments
+    =========
+    file_out_str : string
+        Path to CSV file.
+    mesh_ptr : MeshLine2*
+        Mesh where the values are applied.
+    point_value_vec : VectorDouble
+        Values at each point (domain ID as input).
+
+    Returns
+    =======
+    (none)
+
+    */
+
+    // initialize file stream
+    std::ofstream file_out_stream(file_out_str);
+
+    // write to file
+    int num_point = point_value_vec.size();
+    file_out_stream << "gid,position_x,value\n";
+    for (int point_did = 0; point_did < num_point; point_did++)
+    {
+        file_out_stream << mesh_ptr->point_gid_vec[point_did] << ",";
+        file_out_stream << mesh_ptr->point_position_x_vec[point_did] << ",";
+        file_out_stream << point_value_vec[point_did] << "\n";
+    }
+
+}
+
+#endif
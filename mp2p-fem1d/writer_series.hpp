@@ -0,0 +1,352 @@
+#ifndef WRITER_SERIES
+#define WRITER_SERIES
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "container_series.hpp"
+#include "container_typedef.hpp"
+
+class WriterSeries
+{
+    /*
+
+    Writer for binary files with the values of a variable or scalar over several timesteps.
+
+    Variables
+    =========
+    file_out_str_in : string
+        Path to binary file.
+    is_compressed_in : bool
+        true if values are compressed before writing.
+
+    Functions
+    =========
+    write_header : void
+        Creates the file and its index and writes the point data.
+    write_record : void
+        Appends the values at a timestep to the file and its index.
+    flush : void
+        Writes buffered records to the file and its index.
+    close : void
+        Flushes and closes the file and its index.
+
+    Notes
+    =====
+    The layout of the file is described in container_series.hpp.
+    The file is append-only; each timestep adds one record and one index entry.
+    The file and its index are kept open between records and are flushed when the writer is flushed, closed, or destroyed.
+    Records may only be read by ReaderSeries after the writer is flushed or closed.
+    Values are stored in full (float64) precision.
+    Compression is lossless; values are stored raw if compression does not reduce their size.
+
+    */
+
+    public:
+
+    // file names
+    std::string file_out_str;
+    std::string file_out_index_str;
+
+    // encoding
+    bool is_compressed = false;
+
+    // functions
+    void write_header(const VectorInt &point_gid_vec, const VectorDouble &point_position_x_vec);
+    void write_record(const VectorDouble &point_value_vec, int ts);
+    void flush();
+    void close();
+
+    // default constructor
+    WriterSeries()
+    {
+
+    }
+
+    // constructor
+    WriterSeries(std::string file_out_str_in, bool is_compressed_in)
+    {
+
+        // store variables
+        file_out_str = file_out_str_in;
+        file_out_index_str = file_out_str_in + ".idx";
+        is_compressed = is_compressed_in;
+
+    }
+
+    // destructor
+    ~WriterSeries()
+    {
+        close();
+    }
+
+    // open files cannot be shared between copies
+    WriterSeries(const WriterSeries&) = delete;
+    WriterSeries& operator=(const WriterSeries&) = delete;
+    WriterSeries(WriterSeries&&) = default;
+    WriterSeries& operator=(WriterSeries&&) = default;
+
+    private:
+
+    // file streams kept open between records
+    std::ofstream file_out_stream;
+    std::ofstream file_out_index_stream;
+
+    // functions
+    void encode_compressed(const VectorDouble &value_vec, std::vector<unsigned char> &byte_vec);
+
+};
+
+void WriterSeries::write_header(const VectorInt &point_gid_vec, const VectorDouble &point_position_x_vec)
+{
+    /*
+
+    Creates the file and its index and writes the point data.
+
+    Arguments
+    =========
+    point_gid_vec : VectorInt
+        Global IDs of points.
+    point_position_x_vec : VectorDouble
+        x-coordinates of points.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Existing files are overwritten.
+
+    */
+
+    // initialize file stream
+    // the stream is kept open for write_record
+    close();
+    file_out_stream.open(file_out_str, std::ios::binary | std::ios::trunc);
+
+    // write magic string and number of points
+    int64_t num_point = point_gid_vec.size();
+    file_out_stream.write(series_magic_arr, sizeof(series_magic_arr));
+    file_out_stream.write(reinterpret_cast<const char*>(&num_point), sizeof(int64_t));
+
+    // write global IDs and x-coordinates
+    // x-coordinates start at a multiple of 8 bytes
+    const char padding_arr[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    file_out_stream.write(reinterpret_cast<const char*>(point_gid_vec.data()), num_point*sizeof(int32_t));
+    file_out_stream.write(padding_arr, (num_point % 2)*sizeof(int32_t));
+    file_out_stream.write(reinterpret_cast<const char*>(point_position_x_vec.data()), num_point*sizeof(double));
+
+    // create empty index file
+    file_out_index_stream.open(file_out_index_str, std::ios::binary | std::ios::trunc);
+
+}
+
+void WriterSeries::write_record(const VectorDouble &point_value_vec, int ts)
+{
+    /*
+
+    Appends the values at a timestep to the file and its index.
+
+    Arguments
+    =========
+    point_value_vec : VectorDouble
+        Values at each point.
+    ts : int
+        Timestep number.
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    write_header must be called before the first record is written.
+    If write_header was called by another writer, the file and its index are opened for appending.
+
+    */
+
+    // encode values
+    // use raw values if compression does not reduce the size
+    SeriesRecordStruct record;
+    record.ts = ts;
+    record.num_value = point_value_vec.size();
+    record.encoding = series_encoding_raw;
+    record.num_byte = record.num_value*sizeof(double);
+    const char *byte_ptr = reinterpret_cast<const char*>(point_value_vec.data());
+    std::vector<unsigned char> byte_vec;
+    if (is_compressed)
+    {
+        encode_compressed(point_value_vec, byte_vec);
+        if (static_cast<int64_t>(byte_vec.size()) < record.num_byte)
+        {
+            record.encoding = series_encoding_compressed;
+            record.num_byte = byte_vec.size();
+            byte_ptr = reinterpret_cast<const char*>(byte_vec.data());
+        }
+    }
+
+    // open files if the header was written by another writer
+    if (!file_out_stream.is_open())
+    {
+        file_out_stream.open(file_out_str, std::ios::binary | std::ios::app);
+    }
+    if (!file_out_index_stream.is_open())
+    {
+        file_out_index_stream.open(file_out_index_str, std::ios::binary | std::ios::app);
+    }
+
+    // get position of record at end of file
+    file_out_stream.seekp(0, std::ios::end);
+    int64_t offset = file_out_stream.tellp();
+
+    // write record
+    // pad record so that the next record starts at a multiple of 8 bytes
+    const char padding_arr[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    file_out_stream.write(reinterpret_cast<const char*>(&record), sizeof(SeriesRecordStruct));
+    file_out_stream.write(byte_ptr, record.num_byte);
+    file_out_stream.write(padding_arr, (8 - record.num_byte % 8) % 8);
+
+    // append to index
+    SeriesIndexStruct index_entry = {record.ts, offset};
+    file_out_index_stream.write(reinterpret_cast<const char*>(&index_entry), sizeof(SeriesIndexStruct));
+
+}
+
+void WriterSeries::flush()
+{
+    /*
+
+    Writes buffered records to the file and its index.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    The file and its index stay open for later records.
+
+    */
+
+    if (file_out_stream.is_open())
+    {
+        file_out_stream.flush();
+    }
+    if (file_out_index_stream.is_open())
+    {
+        file_out_index_stream.flush();
+    }
+
+}
+
+void WriterSeries::close()
+{
+    /*
+
+    Flushes and closes the file and its index.
+
+    Arguments
+    =========
+    (none)
+
+    Returns
+    =======
+    (none)
+
+    Notes
+    =====
+    Called by the destructor.
+    Later calls to write_record open the files again for appending.
+
+    */
+
+    if (file_out_stream.is_open())
+    {
+        file_out_stream.close();
+    }
+    if (file_out_index_stream.is_open())
+    {
+        file_out_index_stream.close();
+    }
+
+}
+
+void WriterSeries::encode_compressed(const VectorDouble &value_vec, std::vector<unsigned char> &byte_vec)
+{
+
+    // shuffle bytes
+    // byte b of each value is stored in plane b
+    // bytes with the sign, exponent, and leading mantissa bits are often identical between neighboring points
+    int num_value = value_vec.size();
+    std::vector<unsigned char> plane_vec(8*num_value);
+    const unsigned char *value_byte_ptr = reinterpret_cast<const unsigned char*>(value_vec.data());
+    for (int indx_v = 0; indx_v < num_value; indx_v++){
+    for (int indx_b = 0; indx_b < 8; indx_b++){
+        plane_vec[indx_b*num_value + indx_v] = value_byte_ptr[8*indx_v + indx_b];
+    }}
+
+    // delta-code each plane
+    // identical neighboring bytes become zeros
+    for (int indx_b = 0; indx_b < 8; indx_b++){
+    for (int indx_v = num_value - 1; indx_v > 0; indx_v--){
+        plane_vec[indx_b*num_value + indx_v] -= plane_vec[indx_b*num_value + indx_v - 1];
+    }}
+
+    // run-length encode
+    // control byte c < 128: c + 1 literal bytes follow
+    // control byte c >= 128: the next byte is repeated c - 125 times
+    byte_vec.clear();
+    byte_vec.reserve(plane_vec.size());
+    int num_plane_byte = plane_vec.size();
+    int indx_p = 0;
+    while (indx_p < num_plane_byte)
+    {
+
+        // count repeated bytes
+        int num_repeat = 1;
+        while (indx_p + num_repeat < num_plane_byte && num_repeat < 130 && plane_vec[indx_p + num_repeat] == plane_vec[indx_p])
+        {
+            num_repeat++;
+        }
+
+        // store run of repeated bytes
+        if (num_repeat >= 3)
+        {
+            byte_vec.push_back(static_cast<unsigned char>(num_repeat + 125));
+            byte_vec.push_back(plane_vec[indx_p]);
+            indx_p += num_repeat;
+            continue;
+        }
+
+        // count literal bytes until the next run of at least 3 repeated bytes
+        int num_literal = 0;
+        while (indx_p + num_literal < num_plane_byte && num_literal < 128)
+        {
+            int indx_q = indx_p + num_literal;
+            bool is_run = (
+                indx_q + 2 < num_plane_byte &&
+                plane_vec[indx_q] == plane_vec[indx_q + 1] && plane_vec[indx_q] == plane_vec[indx_q + 2]
+            );
+            if (is_run)
+            {
+                break;
+            }
+            num_literal++;
+        }
+
+        // store literal bytes
+        byte_vec.push_back(static_cast<unsigned char>(num_literal - 1));
+        byte_vec.insert(byte_vec.end(), plane_vec.begin() + indx_p, plane_vec.begin() + indx_p + num_literal);
+        indx_p += num_literal;
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,222 @@
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../mp2p-fem1d/mp2p_fem1d.hpp"
+
+/*
+
+Test of Newton iterations with variables on different domains.
+
+Uses diffusion_steady case 06, where c1 exists in domain 1 and c2 in domains 1 and 2, coupled by a reaction in domain 1.
+Newton iterations are compared with Picard iterations, including derivatives supplied on domains where the variable does not exist.
+Run from the tests directory; returns 0 if all checks pass.
+
+*/
+
+int num_failure = 0;
+
+void check(bool is_passed, std::string message_str)
+{
+    std::cout << (is_passed ? "PASS: " : "FAIL: ") << message_str << "\n";
+    if (!is_passed)
+    {
+        num_failure++;
+    }
+}
+
+double get_difference_max(const VectorDouble &value_a_vec, const VectorDouble &value_b_vec)
+{
+    double difference_max = 0.;
+    int num_value = value_a_vec.size();
+    for (int indx_i = 0; indx_i < num_value; indx_i++)
+    {
+        difference_max = std::max(difference_max, std::abs(value_a_vec[indx_i] - value_b_vec[indx_i]));
+    }
+    return difference_max;
+}
+
+struct ResultStruct
+{
+    bool is_valid;  // matrix equation is valid
+    bool is_solved;  // all iterations were solved
+    int num_iteration;  // iterations to convergence
+    int num_point_c1;  // points in the field of c1
+    VectorDouble c1_dom1_vec;
+    VectorDouble c2_dom1_vec;
+    VectorDouble c2_dom2_vec;
+};
+
+ResultStruct solve_case06(bool is_newton, bool is_derivative_all_domain, bool is_derivative_invalid)
+{
+    /*
+
+    Solves diffusion_steady case 06.
+    Newton iterations start after three Picard iterations, as Newton from a zero guess may converge to a nonphysical root.
+    is_derivative_all_domain supplies dr2/dc1 on domains 1 and 2 although c1 only exists in domain 1.
+    is_derivative_invalid adds a derivative with respect to a variable that is not solved for.
+
+    */
+
+    // variables
+    double c1_a = 0.30;
+    double c2_a = 0.20;
+    double c2_b = 0.10;
+    double diff1 = 0.05;
+    double diff2 = 0.006;
+    double k = 0.40;
+
+    // set up meshes, boundaries, and integrals
+    MeshLine2 mesh_dom1("../diffusion_steady/input/06_input/mesh_point_dom1.csv", "../diffusion_steady/input/06_input/mesh_element_dom1.csv");
+    MeshLine2 mesh_dom2("../diffusion_steady/input/06_input/mesh_point_dom2.csv", "../diffusion_steady/input/06_input/mesh_element_dom2.csv");
+    BoundaryLine2 boundary_c1_dom1("../diffusion_steady/input/06_input/boundary_flux_dom1_c1.csv", "../diffusion_steady/input/06_input/boundary_value_dom1_c1.csv");
+    boundary_c1_dom1.set_boundarycondition(0, "dirichlet", {c1_a});
+    boundary_c1_dom1.set_boundarycondition(1, "neumann", {0});
+    BoundaryLine2 boundary_c2_dom1("../diffusion_steady/input/06_input/boundary_flux_dom1_c2.csv", "../diffusion_steady/input/06_input/boundary_value_dom1_c2.csv");
+    boundary_c2_dom1.set_boundarycondition(2, "dirichlet", {c2_a});
+    BoundaryLine2 boundary_c2_dom2("../diffusion_steady/input/06_input/boundary_flux_dom2_c2.csv", "../diffusion_steady/input/06_input/boundary_value_dom2_c2.csv");
+    boundary_c2_dom2.set_boundarycondition(3, "dirichlet", {c2_b});
+    IntegralLine2 integral_dom1(mesh_dom1);
+    IntegralLine2 integral_dom2(mesh_dom2);
+
+    // set up variables and scalars
+    VariableLine2 c1_dom1(mesh_dom1, 0.0);
+    VariableLine2 c2_dom1(mesh_dom1, 0.0);
+    VariableLine2 c2_dom2(mesh_dom2, 0.0);
+    VariableLine2 c3_dom1(mesh_dom1, 0.0);  // not solved for
+    ScalarLine2 diff1_dom1(mesh_dom1, diff1);
+    ScalarLine2 diff2_dom1(mesh_dom1, diff2);
+    ScalarLine2 diff2_dom2(mesh_dom2, diff2);
+    ScalarLine2 rxnrate1_dom1(mesh_dom1, 0.0);
+    ScalarLine2 rxnrate2_dom1(mesh_dom1, 0.0);
+    ScalarLine2 rxnrate2_dom2(mesh_dom2, 0.0);
+
+    // derivatives of reaction rates
+    ScalarLine2 dr1dc1_dom1(mesh_dom1, 0.0);
+    ScalarLine2 dr1dc2_dom1(mesh_dom1, 0.0);
+    ScalarLine2 dr2dc1_dom1(mesh_dom1, 0.0);
+    ScalarLine2 dr2dc1_dom2(mesh_dom2, 0.0);
+    ScalarLine2 dr2dc2_dom1(mesh_dom1, 0.0);
+    ScalarLine2 dr2dc2_dom2(mesh_dom2, 0.0);
+
+    // group for species 1 (domain 1) and species 2 (domains 1 and 2)
+    MeshField mesh_fld1({&mesh_dom1});
+    BoundaryField boundary_fld1({&boundary_c1_dom1});
+    IntegralField integral_fld1({&integral_dom1});
+    VariableField c1_fld1({&c1_dom1});
+    VariableField c3_fld1({&c3_dom1});
+    ScalarField diff1_fld1({&diff1_dom1});
+    ScalarField rxnrate1_fld1({&rxnrate1_dom1});
+    MeshField mesh_fld2({&mesh_dom1, &mesh_dom2});
+    BoundaryField boundary_fld2({&boundary_c2_dom1, &boundary_c2_dom2});
+    IntegralField integral_fld2({&integral_dom1, &integral_dom2});
+    VariableField c2_fld2({&c2_dom1, &c2_dom2});
+    ScalarField diff2_fld2({&diff2_dom1, &diff2_dom2});
+    ScalarField rxnrate2_fld2({&rxnrate2_dom1, &rxnrate2_dom2});
+    ScalarField dr1dc1_fld1({&dr1dc1_dom1});
+    ScalarField dr1dc2_fld1({&dr1dc2_dom1});
+    ScalarField dr2dc1_fld1({&dr2dc1_dom1});
+    ScalarField dr2dc1_fld2({&dr2dc1_dom1, &dr2dc1_dom2});
+    ScalarField dr2dc2_fld2({&dr2dc2_dom1, &dr2dc2_dom2});
+
+    // set up physics
+    PhysicsSteadyDiffusion diffusion1(mesh_fld1, boundary_fld1, integral_fld1, c1_fld1, diff1_fld1, rxnrate1_fld1);
+    PhysicsSteadyDiffusion diffusion2(mesh_fld2, boundary_fld2, integral_fld2, c2_fld2, diff2_fld2, rxnrate2_fld2);
+    diffusion1.set_generation_derivative(c1_fld1, dr1dc1_fld1);
+    diffusion1.set_generation_derivative(c2_fld2, dr1dc2_fld1);
+    diffusion2.set_generation_derivative(c1_fld1, is_derivative_all_domain ? dr2dc1_fld2 : dr2dc1_fld1);
+    diffusion2.set_generation_derivative(c2_fld2, dr2dc2_fld2);
+    if (is_derivative_invalid)
+    {
+        diffusion1.set_generation_derivative(c3_fld1, dr1dc1_fld1);
+    }
+
+    // set up matrix equation
+    MatrixEquationSteady matrixeq({&diffusion1, &diffusion2});
+
+    // iterate to convergence
+    ResultStruct result;
+    result.is_valid = matrixeq.is_valid;
+    result.is_solved = true;
+    result.num_iteration = -1;
+    for (int it = 0; it < 500; it++)
+    {
+
+        // update reaction rates and their derivatives in domain 1
+        for (int point_did = 0; point_did < mesh_dom1.num_point_domain; point_did++)
+        {
+            double c1 = c1_dom1.point_value_vec[point_did];
+            double c2 = c2_dom1.point_value_vec[point_did];
+            rxnrate1_dom1.point_value_vec[point_did] = -k*c1*c2;
+            rxnrate2_dom1.point_value_vec[point_did] = +k*c1*c2;
+            dr1dc1_dom1.point_value_vec[point_did] = -k*c2;
+            dr1dc2_dom1.point_value_vec[point_did] = -k*c1;
+            dr2dc1_dom1.point_value_vec[point_did] = +k*c2;
+            dr2dc2_dom1.point_value_vec[point_did] = +k*c1;
+        }
+
+        // solve
+        matrixeq.set_newton(is_newton && it >= 3);
+        Eigen::VectorXd x_last_iteration_vec = matrixeq.x_vec;
+        if (!matrixeq.iterate_solution())
+        {
+            result.is_solved = false;
+            break;
+        }
+        matrixeq.store_solution();
+        if ((matrixeq.x_vec - x_last_iteration_vec).norm() < 1e-12)
+        {
+            result.num_iteration = it + 1;
+            break;
+        }
+
+    }
+
+    result.num_point_c1 = c1_fld1.point_gid_to_fid_map.size();
+    result.c1_dom1_vec = c1_dom1.point_value_vec;
+    result.c2_dom1_vec = c2_dom1.point_value_vec;
+    result.c2_dom2_vec = c2_dom2.point_value_vec;
+    return result;
+
+}
+
+bool is_result_equal(ResultStruct &result_a, ResultStruct &result_b, double tolerance)
+{
+    return (
+        get_difference_max(result_a.c1_dom1_vec, result_b.c1_dom1_vec) < tolerance &&
+        get_difference_max(result_a.c2_dom1_vec, result_b.c2_dom1_vec) < tolerance &&
+        get_difference_max(result_a.c2_dom2_vec, result_b.c2_dom2_vec) < tolerance
+    );
+}
+
+int main()
+{
+
+    // tolerance of differences with Picard iterations
+    double tolerance = 1e-8;
+
+    // Picard iterations as reference
+    ResultStruct result_picard = solve_case06(false, false, false);
+    check(result_picard.is_valid && result_picard.is_solved && result_picard.num_iteration > 0, "Picard iterations converge");
+
+    // Newton iterations
+    ResultStruct result_newton = solve_case06(true, false, false);
+    check(result_newton.is_valid && result_newton.is_solved && result_newton.num_iteration > 0, "Newton iterations converge");
+    check(is_result_equal(result_newton, result_picard, tolerance), "Newton iterations match Picard iterations");
+    check(result_newton.num_iteration < result_picard.num_iteration, "Newton iterations converge in fewer iterations");
+
+    // derivative supplied on a domain where the variable does not exist
+    // entries for points outside the field of c1 are skipped
+    ResultStruct result_newton_all = solve_case06(true, true, false);
+    check(result_newton_all.num_point_c1 == result_newton.num_point_c1, "field of c1 is not extended by derivatives on other domains");
+    check(result_newton_all.is_valid && result_newton_all.is_solved && result_newton_all.num_iteration > 0, "Newton iterations with derivatives on all domains converge");
+    check(is_result_equal(result_newton_all, result_picard, tolerance), "Newton iterations with derivatives on all domains match Picard iterations");
+
+    // derivative with respect to a variable that is not solved for
+    ResultStruct result_invalid = solve_case06(true, false, true);
+    check(!result_invalid.is_valid, "matrix equation with a derivative of an unsolved variable is invalid");
+    check(!result_invalid.is_solved, "iterate_solution fails for an invalid matrix equation");
+
+    return (num_failure == 0) ? 0 : 1;
+
+}
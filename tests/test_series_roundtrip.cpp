@@ -0,0 +1,148 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../mp2p-fem1d/mp2p_fem1d.hpp"
+
+/*
+
+Round-trip test of binary series output.
+
+Values written with VariableLine2::output_binary are read back with ReaderSeries and compared exactly.
+Covers raw and compressed records, flush_binary, close_binary, copies sharing writers, and damaged or missing index files.
+Run from the tests directory; returns 0 if all checks pass.
+
+*/
+
+int num_failure = 0;
+
+void check(bool is_passed, std::string message_str)
+{
+    std::cout << (is_passed ? "PASS: " : "FAIL: ") << message_str << "\n";
+    if (!is_passed)
+    {
+        num_failure++;
+    }
+}
+
+bool is_record_equal(ReaderSeries &reader, int indx_r, const VectorDouble &value_vec)
+{
+    VectorDouble read_vec = reader.read_record(indx_r);
+    return read_vec == value_vec;
+}
+
+int main()
+{
+
+    // file names
+    std::string file_out_str = "test_series_roundtrip.bin";
+    std::string file_out_index_str = file_out_str + ".idx";
+
+    // initialize mesh and variable
+    MeshLine2 mesh_dom1("../diffusion_steady/input/01_input/mesh_point.csv", "../diffusion_steady/input/01_input/mesh_element.csv");
+    VariableLine2 u_dom1(mesh_dom1, 0.);
+
+    // write timesteps with alternating raw and compressed records
+    // values are smooth in some timesteps (compressible) and irregular in others
+    std::vector<VectorDouble> value_written_vec;
+    int num_ts = 6;
+    for (int ts = 0; ts < num_ts; ts++)
+    {
+        for (int point_did = 0; point_did < u_dom1.num_point_domain; point_did++)
+        {
+            double x = mesh_dom1.point_position_x_vec[point_did];
+            u_dom1.point_value_vec[point_did] = (ts % 3 == 0) ? 1. + 0.5*ts : 1./(1. + x*x + ts) + 1e-7*point_did*point_did;
+        }
+        u_dom1.output_binary(file_out_str, ts, ts % 2 == 1);
+        value_written_vec.push_back(u_dom1.point_value_vec);
+    }
+
+    // read after flush
+    u_dom1.flush_binary();
+    {
+        ReaderSeries reader(file_out_str);
+        check(reader.num_point == mesh_dom1.num_point_domain, "number of points after flush");
+        check(reader.point_gid_vec == mesh_dom1.point_gid_vec, "point global IDs after flush");
+        check(reader.point_position_x_vec == mesh_dom1.point_position_x_vec, "point positions after flush");
+        check(reader.num_record == num_ts, "number of records after flush");
+        bool is_equal = (reader.num_record == num_ts);
+        for (int indx_r = 0; is_equal && indx_r < num_ts; indx_r++)
+        {
+            is_equal = (reader.record_ts_vec[indx_r] == indx_r) && is_record_equal(reader, indx_r, value_written_vec[indx_r]);
+        }
+        check(is_equal, "timesteps and values after flush");
+    }
+
+    // append through a copy, which shares the open file
+    VariableLine2 u_copy_dom1 = u_dom1;
+    u_copy_dom1.point_value_vec[0] = -3.;
+    u_copy_dom1.output_binary(file_out_str, num_ts, true);
+    value_written_vec.push_back(u_copy_dom1.point_value_vec);
+    u_copy_dom1.close_binary();
+    {
+        ReaderSeries reader(file_out_str);
+        check(reader.num_record == num_ts + 1, "number of records after append through copy");
+        check(reader.num_record == num_ts + 1 && is_record_equal(reader, num_ts, value_written_vec[num_ts]), "values appended through copy");
+    }
+
+    // append after close
+    u_dom1.output_binary(file_out_str, num_ts + 1, false);
+    value_written_vec.push_back(u_dom1.point_value_vec);
+    u_dom1.close_binary();
+    int num_record = num_ts + 2;
+    {
+        ReaderSeries reader(file_out_str);
+        check(reader.num_record == num_record, "number of records after append following close");
+        check(reader.num_record == num_record && is_record_equal(reader, num_record - 1, value_written_vec[num_record - 1]), "values appended following close");
+    }
+
+    // empty index file
+    // records are scanned instead
+    {
+        std::ofstream file_index_stream(file_out_index_str, std::ios::trunc);
+    }
+    {
+        ReaderSeries reader(file_out_str);
+        check(reader.num_record == num_record, "number of records with empty index");
+    }
+
+    // partial index entry
+    {
+        std::ofstream file_index_stream(file_out_index_str, std::ios::binary | std::ios::trunc);
+        int64_t entry_arr[1] = {0};
+        file_index_stream.write(reinterpret_cast<char*>(entry_arr), sizeof(entry_arr));
+    }
+    {
+        ReaderSeries reader(file_out_str);
+        check(reader.num_record == num_record, "number of records with partial index");
+    }
+
+    // missing index file
+    std::remove(file_out_index_str.c_str());
+    {
+        ReaderSeries reader(file_out_str);
+        bool is_equal = (reader.num_record == num_record);
+        for (int indx_r = 0; is_equal && indx_r < num_record; indx_r++)
+        {
+            is_equal = (reader.record_ts_vec[indx_r] == indx_r) && is_record_equal(reader, indx_r, value_written_vec[indx_r]);
+        }
+        check(is_equal, "timesteps and values with missing index");
+    }
+
+    // steady-state output has a single record with timestep 0
+    u_dom1.output_binary(file_out_str, false);
+    {
+        ReaderSeries reader(file_out_str);
+        check(reader.num_record == 1 && reader.record_ts_vec[0] == 0, "single record of steady-state output");
+        check(reader.num_record == 1 && is_record_equal(reader, 0, u_dom1.point_value_vec), "values of steady-state output");
+    }
+
+    // clean up
+    std::remove(file_out_str.c_str());
+    std::remove(file_out_index_str.c_str());
+
+    return (num_failure == 0) ? 0 : 1;
+
+}
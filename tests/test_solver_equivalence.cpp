@@ -0,0 +1,353 @@
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../mp2p-fem1d/mp2p_fem1d.hpp"
+
+/*
+
+Equivalence test of the matrix solvers.
+
+The same problems are solved with each solver and compared with the default sparse LU decomposition.
+Covers a coupled nonlinear steady problem (Picard iterations), a symmetric steady problem, a transient problem, and a singular matrix.
+Run from the tests directory; returns 0 if all checks pass.
+
+*/
+
+int num_failure = 0;
+
+void check(bool is_passed, std::string message_str)
+{
+    std::cout << (is_passed ? "PASS: " : "FAIL: ") << message_str << "\n";
+    if (!is_passed)
+    {
+        num_failure++;
+    }
+}
+
+double get_difference_max(const VectorDouble &value_a_vec, const VectorDouble &value_b_vec)
+{
+    double difference_max = 0.;
+    int num_value = value_a_vec.size();
+    for (int indx_i = 0; indx_i < num_value; indx_i++)
+    {
+        difference_max = std::max(difference_max, std::abs(value_a_vec[indx_i] - value_b_vec[indx_i]));
+    }
+    return difference_max;
+}
+
+bool solve_coupled(MatrixSolverBase *solver_ptr, bool is_condensed, VectorDouble &c1_out_vec, VectorDouble &c2_out_vec)
+{
+    /*
+
+    Solves diffusion_steady case 05 (two species reacting in one domain) with Picard iterations.
+    Returns false if the matrix equation could not be solved.
+
+    */
+
+    // variables
+    double c1_a = 0.1;
+    double j2_a = 0.002;
+    double j1_b = 0.003;
+    double c2_b = 0.4;
+    double diff1 = 0.05;
+    double diff2 = 0.006;
+    double k = 0.07;
+
+    // set up mesh, boundaries, and integrals
+    MeshLine2 mesh_dom1("../diffusion_steady/input/05_input/mesh_point.csv", "../diffusion_steady/input/05_input/mesh_element.csv");
+    BoundaryLine2 boundary_c1_dom1("../diffusion_steady/input/05_input/boundary_flux_c1.csv", "../diffusion_steady/input/05_input/boundary_value_c1.csv");
+    boundary_c1_dom1.set_boundarycondition(0, "neumann", {-j1_b});
+    boundary_c1_dom1.set_boundarycondition(1, "dirichlet", {c1_a});
+    BoundaryLine2 boundary_c2_dom1("../diffusion_steady/input/05_input/boundary_flux_c2.csv", "../diffusion_steady/input/05_input/boundary_value_c2.csv");
+    boundary_c2_dom1.set_boundarycondition(2, "neumann", {-j2_a});
+    boundary_c2_dom1.set_boundarycondition(3, "dirichlet", {c2_b});
+    IntegralLine2 integral_dom1(mesh_dom1);
+
+    // set up variables and scalars
+    VariableLine2 c1_dom1(mesh_dom1, 0.0);
+    VariableLine2 c2_dom1(mesh_dom1, 0.0);
+    ScalarLine2 diff1_dom1(mesh_dom1, diff1);
+    ScalarLine2 diff2_dom1(mesh_dom1, diff2);
+    ScalarLine2 rxnrate1_dom1(mesh_dom1, 0.0);
+    ScalarLine2 rxnrate2_dom1(mesh_dom1, 0.0);
+
+    // set up physics
+    MeshField mesh_fld1({&mesh_dom1});
+    BoundaryField boundary_c1_fld1({&boundary_c1_dom1});
+    BoundaryField boundary_c2_fld1({&boundary_c2_dom1});
+    IntegralField integral_fld1({&integral_dom1});
+    VariableField c1_fld1({&c1_dom1});
+    VariableField c2_fld1({&c2_dom1});
+    ScalarField diff1_fld1({&diff1_dom1});
+    ScalarField diff2_fld1({&diff2_dom1});
+    ScalarField rxnrate1_fld1({&rxnrate1_dom1});
+    ScalarField rxnrate2_fld1({&rxnrate2_dom1});
+    PhysicsSteadyDiffusion diffusion1(mesh_fld1, boundary_c1_fld1, integral_fld1, c1_fld1, diff1_fld1, rxnrate1_fld1);
+    PhysicsSteadyDiffusion diffusion2(mesh_fld1, boundary_c2_fld1, integral_fld1, c2_fld1, diff2_fld1, rxnrate2_fld1);
+
+    // set up matrix equation
+    MatrixEquationSteady matrixeq({&diffusion1, &diffusion2});
+    if (solver_ptr != nullptr)
+    {
+        matrixeq.set_solver(*solver_ptr);
+    }
+    matrixeq.set_condensed(is_condensed);
+
+    // iterate to convergence
+    for (int it = 0; it < 200; it++)
+    {
+
+        // update reaction rates
+        for (int point_did = 0; point_did < mesh_dom1.num_point_domain; point_did++)
+        {
+            double rxnrate = k*c1_dom1.point_value_vec[point_did]*c2_dom1.point_value_vec[point_did];
+            rxnrate1_dom1.point_value_vec[point_did] = -rxnrate;
+            rxnrate2_dom1.point_value_vec[point_did] = rxnrate;
+        }
+
+        // solve
+        Eigen::VectorXd x_last_iteration_vec = matrixeq.x_vec;
+        if (!matrixeq.iterate_solution())
+        {
+            return false;
+        }
+        matrixeq.store_solution();
+        if ((matrixeq.x_vec - x_last_iteration_vec).norm() < 1e-13)
+        {
+            break;
+        }
+
+    }
+
+    c1_out_vec = c1_dom1.point_value_vec;
+    c2_out_vec = c2_dom1.point_value_vec;
+    return true;
+
+}
+
+bool solve_symmetric(MatrixSolverBase *solver_ptr, VectorDouble &temp_out_vec)
+{
+    /*
+
+    Solves diffusion_steady case 01 with value BCs eliminated symmetrically.
+    Returns false if the matrix equation could not be solved.
+
+    */
+
+    // set up mesh, boundaries, and integrals
+    MeshLine2 mesh_dom1("../diffusion_steady/input/01_input/mesh_point.csv", "../diffusion_steady/input/01_input/mesh_element.csv");
+    BoundaryLine2 boundary_dom1("../diffusion_steady/input/01_input/boundary_flux.csv", "../diffusion_steady/input/01_input/boundary_value.csv");
+    boundary_dom1.set_boundarycondition(0, "neumann", {2.});
+    boundary_dom1.set_boundarycondition(1, "dirichlet", {50.});
+    IntegralLine2 integral_dom1(mesh_dom1);
+
+    // set up variables and scalars
+    VariableLine2 temp_dom1(mesh_dom1, 0.0);
+    ScalarLine2 thermcond_dom1(mesh_dom1, 1.);
+    ScalarLine2 heatgen_dom1(mesh_dom1, 100.);
+
+    // set up physics
+    MeshField mesh_fld1({&mesh_dom1});
+    BoundaryField boundary_fld1({&boundary_dom1});
+    IntegralField integral_fld1({&integral_dom1});
+    VariableField temp_fld1({&temp_dom1});
+    ScalarField thermcond_fld1({&thermcond_dom1});
+    ScalarField heatgen_fld1({&heatgen_dom1});
+    PhysicsSteadyDiffusion heattransfer(mesh_fld1, boundary_fld1, integral_fld1, temp_fld1, thermcond_fld1, heatgen_fld1);
+    heattransfer.set_dirichlet_symmetric(true);
+
+    // solve
+    MatrixEquationSteady matrixeq({&heattransfer});
+    if (solver_ptr != nullptr)
+    {
+        matrixeq.set_solver(*solver_ptr);
+    }
+    if (!matrixeq.iterate_solution())
+    {
+        return false;
+    }
+    matrixeq.store_solution();
+
+    temp_out_vec = temp_dom1.point_value_vec;
+    return true;
+
+}
+
+void solve_transient(MatrixSolverBase *solver_ptr, std::string integrator_str, VectorDouble &temp_out_vec)
+{
+    /*
+
+    Solves diffusion_transient case 01 for 20 timesteps.
+
+    */
+
+    // set up mesh, boundaries, and integrals
+    MeshLine2 mesh_dom1("../diffusion_transient/input/01_input/mesh_point.csv", "../diffusion_transient/input/01_input/mesh_element.csv");
+    BoundaryLine2 boundary_dom1("../diffusion_transient/input/01_input/boundary_flux.csv", "../diffusion_transient/input/01_input/boundary_value.csv");
+    boundary_dom1.set_boundarycondition(0, "neumann", {0.});
+    boundary_dom1.set_boundarycondition(1, "dirichlet", {50.});
+    IntegralLine2 integral_dom1(mesh_dom1);
+
+    // set up variables and scalars
+    VariableLine2 temp_dom1(mesh_dom1, 0.);
+    ScalarLine2 heatcap_dom1(mesh_dom1, 1.);
+    ScalarLine2 thermcond_dom1(mesh_dom1, 1.);
+    ScalarLine2 heatgen_dom1(mesh_dom1, 0.);
+
+    // set up physics
+    MeshField mesh_fld1({&mesh_dom1});
+    BoundaryField boundary_fld1({&boundary_dom1});
+    IntegralField integral_fld1({&integral_dom1});
+    VariableField temp_fld1({&temp_dom1});
+    ScalarField heatcap_fld1({&heatcap_dom1});
+    ScalarField thermcond_fld1({&thermcond_dom1});
+    ScalarField heatgen_fld1({&heatgen_dom1});
+    PhysicsTransientDiffusion heattransfer(mesh_fld1, boundary_fld1, integral_fld1, temp_fld1, heatcap_fld1, thermcond_fld1, heatgen_fld1);
+
+    // set up matrix equation
+    MatrixEquationTransient matrixeq({&heattransfer});
+    matrixeq.set_integrator(integrator_str);
+    if (solver_ptr != nullptr)
+    {
+        matrixeq.set_solver(*solver_ptr);
+    }
+
+    // iterate through each timestep
+    for (int ts = 1; ts <= 20; ts++)
+    {
+        matrixeq.iterate_solution(0.005);
+        matrixeq.store_solution();
+        matrixeq.set_last_timestep_solution();
+    }
+
+    temp_out_vec = temp_dom1.point_value_vec;
+
+}
+
+void check_singular(MatrixSolverBase &solver, std::string solver_str)
+{
+    /*
+
+    Checks that a singular matrix is reported and x is left unchanged.
+
+    */
+
+    // tridiagonal matrix with a decoupled zero row and column
+    int num_equation = 20;
+    int row_zero = num_equation/2;
+    std::vector<Eigen::Triplet<double>> a_triplet_vec;
+    for (int mat_row = 0; mat_row < num_equation; mat_row++)
+    {
+        a_triplet_vec.push_back(Eigen::Triplet<double>(mat_row, mat_row, (mat_row == row_zero) ? 0. : 2.));
+        if (mat_row > 0 && mat_row != row_zero && mat_row - 1 != row_zero)
+        {
+            a_triplet_vec.push_back(Eigen::Triplet<double>(mat_row, mat_row - 1, -1.));
+            a_triplet_vec.push_back(Eigen::Triplet<double>(mat_row - 1, mat_row, -1.));
+        }
+    }
+    Eigen::SparseMatrix<double> a_mat(num_equation, num_equation);
+    a_mat.setFromTriplets(a_triplet_vec.begin(), a_triplet_vec.end());
+    a_mat.makeCompressed();
+    Eigen::VectorXd b_vec = Eigen::VectorXd::Ones(num_equation);
+    Eigen::VectorXd x_vec = Eigen::VectorXd::Constant(num_equation, 7.);
+
+    // solve
+    solver.solve(a_mat, b_vec, x_vec);
+    check(!solver.get_is_converged(), solver_str + " reports singular matrix");
+    solver.solve_factorized(a_mat, b_vec, x_vec);
+    check(!solver.get_is_converged(), solver_str + " reports singular matrix when reusing factorization");
+
+}
+
+int main()
+{
+
+    // tolerance of differences with sparse LU
+    double tolerance = 1e-8;
+
+    // coupled nonlinear problem
+    // A is nonsymmetric because rows with value BCs are replaced
+    VectorDouble c1_ref_vec, c2_ref_vec;
+    check(solve_coupled(nullptr, false, c1_ref_vec, c2_ref_vec), "coupled problem with sparse LU");
+    {
+        MatrixSolverBanded solver_banded;
+        MatrixSolverBanded solver_banded_fallback(0);
+        MatrixSolverIterative solver_bicgstab_jacobi("bicgstab", "jacobi", 1e-13, 0);
+        MatrixSolverIterative solver_bicgstab_incomplete("bicgstab", "incomplete", 1e-13, 0);
+        std::vector<MatrixSolverBase*> solver_ptr_vec = {&solver_banded, &solver_banded_fallback, &solver_bicgstab_jacobi, &solver_bicgstab_incomplete, nullptr};
+        std::vector<std::string> solver_str_vec = {"banded", "banded with sparse LU fallback", "bicgstab with jacobi", "bicgstab with incomplete LU", "condensed sparse LU"};
+        int num_solver = solver_ptr_vec.size();
+        for (int indx_s = 0; indx_s < num_solver; indx_s++)
+        {
+            VectorDouble c1_vec, c2_vec;
+            bool is_solved = solve_coupled(solver_ptr_vec[indx_s], indx_s == num_solver - 1, c1_vec, c2_vec);
+            check(
+                is_solved && get_difference_max(c1_vec, c1_ref_vec) < tolerance && get_difference_max(c2_vec, c2_ref_vec) < tolerance,
+                "coupled problem with " + solver_str_vec[indx_s] + " matches sparse LU"
+            );
+        }
+    }
+
+    // symmetric problem
+    VectorDouble temp_ref_vec;
+    check(solve_symmetric(nullptr, temp_ref_vec), "symmetric problem with sparse LU");
+    {
+        MatrixSolverLDLT solver_ldlt;
+        MatrixSolverIterative solver_cg_jacobi("cg", "jacobi", 1e-13, 0);
+        MatrixSolverIterative solver_cg_incomplete("cg", "incomplete", 1e-13, 0);
+        std::vector<MatrixSolverBase*> solver_ptr_vec = {&solver_ldlt, &solver_cg_jacobi, &solver_cg_incomplete};
+        std::vector<std::string> solver_str_vec = {"LDLT", "cg with jacobi", "cg with incomplete Cholesky"};
+        int num_solver = solver_ptr_vec.size();
+        for (int indx_s = 0; indx_s < num_solver; indx_s++)
+        {
+            VectorDouble temp_vec;
+            bool is_solved = solve_symmetric(solver_ptr_vec[indx_s], temp_vec);
+            check(is_solved && get_difference_max(temp_vec, temp_ref_vec) < tolerance, "symmetric problem with " + solver_str_vec[indx_s] + " matches sparse LU");
+        }
+    }
+
+    // nonsymmetric problem with solvers that require symmetry
+    {
+        MatrixSolverLDLT solver_ldlt;
+        MatrixSolverIterative solver_cg("cg", "jacobi", 1e-13, 0);
+        VectorDouble c1_vec, c2_vec;
+        check(!solve_coupled(&solver_ldlt, false, c1_vec, c2_vec), "LDLT reports nonsymmetric matrix");
+        check(!solve_coupled(&solver_cg, false, c1_vec, c2_vec), "cg reports nonsymmetric matrix");
+        solver_cg.set_fallback(true);
+        bool is_solved = solve_coupled(&solver_cg, false, c1_vec, c2_vec);
+        check(is_solved && get_difference_max(c1_vec, c1_ref_vec) < tolerance, "cg with sparse LU fallback matches sparse LU");
+    }
+
+    // transient problem
+    // factorizations are reused across timesteps and stages
+    for (std::string integrator_str : {"backwardeuler", "sdirk2"})
+    {
+        VectorDouble temp_transient_ref_vec;
+        solve_transient(nullptr, integrator_str, temp_transient_ref_vec);
+        MatrixSolverBanded solver_banded;
+        MatrixSolverIterative solver_bicgstab("bicgstab", "incomplete", 1e-13, 0);
+        VectorDouble temp_banded_vec, temp_bicgstab_vec;
+        solve_transient(&solver_banded, integrator_str, temp_banded_vec);
+        solve_transient(&solver_bicgstab, integrator_str, temp_bicgstab_vec);
+        check(get_difference_max(temp_banded_vec, temp_transient_ref_vec) < tolerance, "transient problem (" + integrator_str + ") with banded matches sparse LU");
+        check(get_difference_max(temp_bicgstab_vec, temp_transient_ref_vec) < tolerance, "transient problem (" + integrator_str + ") with bicgstab matches sparse LU");
+    }
+
+    // singular matrix
+    {
+        MatrixSolverSparseLU solver_sparselu;
+        MatrixSolverLDLT solver_ldlt;
+        MatrixSolverBanded solver_banded;
+        MatrixSolverBanded solver_banded_fallback(0);
+        MatrixSolverIterative solver_cg("cg", "jacobi", 1e-10, 0);
+        check_singular(solver_sparselu, "sparse LU");
+        check_singular(solver_ldlt, "LDLT");
+        check_singular(solver_banded, "banded");
+        check_singular(solver_banded_fallback, "banded with sparse LU fallback");
+        check_singular(solver_cg, "cg");
+    }
+
+    return (num_failure == 0) ? 0 : 1;
+
+}